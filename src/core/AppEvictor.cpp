@@ -0,0 +1,133 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AppEvictor.h"
+
+#include <algorithm>
+
+#include "LaunchTimeline.h"
+#include "WebAppBase.h"
+#include "WebAppRegistry.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+AppEvictor::AppEvictor()
+    : m_episodes(0)
+    , m_evictions(0)
+    , m_freedKB(0)
+{
+}
+
+std::vector<AppEvictor::Victim> AppEvictor::select(const WebAppRegistry& apps, WebProcessManager& processes, uint64_t budgetKB) const
+{
+    std::vector<AppState> states;
+    QHash<uint32_t, unsigned> appsPerProcess;
+    for (WebAppBase* app : apps) {
+        if (!app->page())
+            continue;
+
+        uint32_t pid = processes.getWebProcessPID(app);
+        if (pid)
+            appsPerProcess[pid]++;
+
+        states.push_back(AppState{app, pid, app->page()->isClosing(), app->isActivated(), app->keepAlive(),
+                                  app->preloadState() != WebAppBase::NONE_PRELOAD, app->page()->isDiscarded(),
+                                  app->lastForegroundTime()});
+    }
+
+    std::vector<Victim> candidates = AppEvictor::candidates(states, LaunchTimeline::now());
+
+    std::shared_ptr<const ProcessSnapshot> snapshot = processes.processSnapshot();
+    QHash<uint32_t, uint64_t> processKB;
+    for (const Victim& victim : candidates) {
+        if (!victim.pid || processKB.contains(victim.pid))
+            continue;
+
+        const ProcessSample* sample = snapshot ? snapshot->latest(victim.pid) : nullptr;
+        if (sample)
+            processKB[victim.pid] = sample->pss ? sample->pss : sample->rss;
+        else
+            processKB[victim.pid] = processes.getWebProcessMemSize(victim.pid).section(' ', 0, 0).toULongLong();
+    }
+
+    return pick(candidates, appsPerProcess, processKB, budgetKB);
+}
+
+std::vector<AppEvictor::Victim> AppEvictor::candidates(const std::vector<AppState>& apps, int64_t now)
+{
+    std::vector<Victim> candidates;
+    for (const AppState& app : apps) {
+        // A discarded page holds next to nothing to free
+        if (app.closing || app.foreground || app.keepAlive || app.preloaded || app.discarded)
+            continue;
+
+        candidates.push_back(Victim{app.app, app.pid, 0, now - app.lastForegroundTime});
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Victim& a, const Victim& b) { return a.backgroundTime > b.backgroundTime; });
+    return candidates;
+}
+
+std::vector<AppEvictor::Victim> AppEvictor::pick(const std::vector<Victim>& candidates,
+                                                 const QHash<uint32_t, unsigned>& appsPerProcess,
+                                                 const QHash<uint32_t, uint64_t>& processKB, uint64_t budgetKB)
+{
+    std::vector<Victim> victims;
+    QHash<uint32_t, unsigned> appsLeft = appsPerProcess;
+    QHash<uint32_t, uint64_t> creditedKB;
+    uint64_t freedKB = 0;
+    for (Victim victim : candidates) {
+        if (freedKB >= budgetKB)
+            break;
+
+        victim.freedKB = 0;
+        if (victim.pid) {
+            uint64_t totalKB = processKB.value(victim.pid);
+            uint64_t leftKB = totalKB - std::min(creditedKB.value(victim.pid), totalKB);
+            unsigned& left = appsLeft[victim.pid];
+            // Closing the last app ends the renderer and frees all of it;
+            // closing any other frees about its even share only
+            if (left <= 1)
+                victim.freedKB = leftKB;
+            else
+                victim.freedKB = std::min(totalKB / appsPerProcess.value(victim.pid, 1), leftKB);
+            if (left)
+                left--;
+            creditedKB[victim.pid] += victim.freedKB;
+        }
+
+        freedKB += victim.freedKB;
+        victims.push_back(victim);
+    }
+
+    return victims;
+}
+
+void AppEvictor::evicted(const Victim& victim)
+{
+    m_evictions++;
+    m_freedKB += victim.freedKB;
+}
+
+QJsonObject AppEvictor::stats() const
+{
+    QJsonObject stats;
+    stats["episodes"] = static_cast<int>(m_episodes);
+    stats["evictions"] = static_cast<int>(m_evictions);
+    stats["freedKB"] = static_cast<double>(m_freedKB);
+    return stats;
+}
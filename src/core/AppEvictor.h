@@ -0,0 +1,84 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef APPEVICTOR_H
+#define APPEVICTOR_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <QHash>
+#include <QJsonObject>
+
+class WebAppBase;
+class WebAppRegistry;
+class WebProcessManager;
+
+/**
+ * Picks background apps to close under memory pressure.
+ *
+ * Candidates are apps that are neither in the foreground, nor keepAlive,
+ * nor preloaded, nor discarded, least recently foreground first. Each is credited its
+ * share of its renderer's PSS (the renderer split evenly over the apps on
+ * it), or what is left of that PSS when it is the last app on the renderer,
+ * and apps are picked until the budget is covered.
+ */
+class AppEvictor {
+public:
+    struct Victim {
+        WebAppBase* app;
+        uint32_t pid;
+        uint64_t freedKB;
+        int64_t backgroundTime; // us since it was last in the foreground
+    };
+
+    // What select() goes by of each app that has a page
+    struct AppState {
+        WebAppBase* app;
+        uint32_t pid; // of its renderer, 0 if it has none
+        bool closing;
+        bool foreground;
+        bool keepAlive;
+        bool preloaded;
+        bool discarded;
+        int64_t lastForegroundTime; // LaunchTimeline::now() time
+    };
+
+    AppEvictor();
+
+    std::vector<Victim> select(const WebAppRegistry& apps, WebProcessManager& processes, uint64_t budgetKB) const;
+
+    // Apps that may be closed, least recently in the foreground first
+    static std::vector<Victim> candidates(const std::vector<AppState>& apps, int64_t now);
+    // Picks from |candidates|, most preferred first, given the apps on and
+    // the PSS of each renderer
+    static std::vector<Victim> pick(const std::vector<Victim>& candidates,
+                                    const QHash<uint32_t, unsigned>& appsPerProcess,
+                                    const QHash<uint32_t, uint64_t>& processKB, uint64_t budgetKB);
+
+    // Accounts a victim that has been closed
+    void evicted(const Victim& victim);
+    void pressureHandled() { m_episodes++; }
+
+    QJsonObject stats() const;
+
+private:
+    unsigned m_episodes;
+    unsigned m_evictions;
+    uint64_t m_freedKB;
+};
+
+#endif /* APPEVICTOR_H */
@@ -69,67 +69,39 @@ ApplicationDescription::ApplicationDescription()
 {
 }
 
-const ApplicationDescription::WindowGroupInfo ApplicationDescription::getWindowGroupInfo()
+void ApplicationDescription::setWindowGroup(const QJsonObject& windowGroup)
 {
-    ApplicationDescription::WindowGroupInfo info;
+    m_groupWindowDesc = QJsonDocument(windowGroup).toJson().data();
 
-    if (!m_groupWindowDesc.empty()) {
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray(m_groupWindowDesc.c_str()));
-        QJsonObject jsonObject = jsonDoc.object();
+    if (!windowGroup.value("name").isUndefined())
+        m_windowGroupInfo.name = windowGroup.value("name").toString();
+    if (!windowGroup.value("owner").isUndefined())
+        m_windowGroupInfo.isOwner = windowGroup.value("owner").toBool();
 
-        if (!jsonObject.value("name").isUndefined())
-            info.name = jsonObject.value("name").toString();
-        if (!jsonObject.value("owner").isUndefined())
-            info.isOwner = jsonObject.value("owner").toBool();
-    }
+    if (!windowGroup.value("ownerInfo").isUndefined()) {
+        QJsonObject ownerJsonObject = windowGroup.value("ownerInfo").toObject();
+        if (!ownerJsonObject.value("allowAnonymous").isUndefined())
+            m_windowOwnerInfo.allowAnonymous = ownerJsonObject.value("allowAnonymous").toBool();
 
-    return info;
-}
+        if (!ownerJsonObject.value("layers").isUndefined()) {
+            QJsonArray ownerJsonArray = ownerJsonObject.value("layers").toArray();
 
-const ApplicationDescription::WindowOwnerInfo ApplicationDescription::getWindowOwnerInfo()
-{
-    ApplicationDescription::WindowOwnerInfo info;
-    if (!m_groupWindowDesc.empty()) {
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray(m_groupWindowDesc.c_str()));
-        QJsonObject jsonObject = jsonDoc.object();
-
-        if (!jsonObject.value("ownerInfo").isUndefined()) {
-            QJsonObject ownerJsonObject = jsonObject.value("ownerInfo").toObject();
-            if (!ownerJsonObject.value("allowAnonymous").isUndefined())
-                info.allowAnonymous =ownerJsonObject.value("allowAnonymous").toBool();
-
-            if (!ownerJsonObject.value("layers").isUndefined()) {
-                QJsonArray ownerJsonArray = ownerJsonObject.value("layers").toArray();
-
-                for (int i=0; i<ownerJsonArray.size(); i++) {
-                    QVariantMap map = ownerJsonArray[i].toObject().toVariantMap();
-                    if (!map.empty())
-                        info.layers.insert(map["name"].toString(), map["z"].toString().toInt());
-                }
+            for (int i=0; i<ownerJsonArray.size(); i++) {
+                QVariantMap map = ownerJsonArray[i].toObject().toVariantMap();
+                if (!map.empty())
+                    m_windowOwnerInfo.layers.insert(map["name"].toString(), map["z"].toString().toInt());
             }
         }
-
     }
-    return info;
-}
 
-const ApplicationDescription::WindowClientInfo ApplicationDescription::getWindowClientInfo()
-{
-    ApplicationDescription::WindowClientInfo info;
-    if (!m_groupWindowDesc.empty()) {
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray(m_groupWindowDesc.c_str()));
-        QJsonObject jsonObject = jsonDoc.object();
-
-        if (!jsonObject.value("clientInfo").isUndefined()) {
-            QJsonObject clientJsonObject = jsonObject.value("clientInfo").toObject();
-            if (!clientJsonObject.value("layer").isUndefined())
-                info.layer = clientJsonObject.value("layer").toString();
-
-            if (!clientJsonObject.value("hint").isUndefined())
-                info.hint = clientJsonObject.value("hint").toString();
-        }
+    if (!windowGroup.value("clientInfo").isUndefined()) {
+        QJsonObject clientJsonObject = windowGroup.value("clientInfo").toObject();
+        if (!clientJsonObject.value("layer").isUndefined())
+            m_windowClientInfo.layer = clientJsonObject.value("layer").toString();
+
+        if (!clientJsonObject.value("hint").isUndefined())
+            m_windowClientInfo.hint = clientJsonObject.value("hint").toString();
     }
-    return info;
 }
 
 std::unique_ptr<ApplicationDescription> ApplicationDescription::fromJsonString(const char* jsonStr)
@@ -141,8 +113,12 @@ std::unique_ptr<ApplicationDescription> ApplicationDescription::fromJsonString(c
                     PMLOGKFV("JSON", "%s", jsonStr), "Failed to parse JSON string");
         return nullptr;
     }
-    QJsonObject jsonObj = jsonDoc.object();
 
+    return fromJsonObject(jsonDoc.object());
+}
+
+std::unique_ptr<ApplicationDescription> ApplicationDescription::fromJsonObject(const QJsonObject& jsonObj)
+{
     auto appDesc = std::unique_ptr<ApplicationDescription>(new ApplicationDescription());
 
     appDesc->m_transparency = jsonObj["transparent"].toBool();
@@ -158,7 +134,7 @@ std::unique_ptr<ApplicationDescription> ApplicationDescription::fromJsonString(c
     appDesc->m_version = jsonObj["version"].toString().toStdString();
     appDesc->m_customPlugin = jsonObj["customPlugin"].toBool();
     appDesc->m_backHistoryAPIDisabled = jsonObj["disableBackHistoryAPI"].toBool();
-    appDesc->m_groupWindowDesc = QJsonDocument(jsonObj["windowGroup"].toObject()).toJson().data();
+    appDesc->setWindowGroup(jsonObj["windowGroup"].toObject());
 
     if (jsonObj.contains("supportedEnyoBundleVersions")) {
         QJsonArray versions = jsonObj["supportedEnyoBundleVersions"].toArray();
@@ -120,6 +120,7 @@ public:
     }
 
     static std::unique_ptr<ApplicationDescription> fromJsonString(const char* jsonStr);
+    static std::unique_ptr<ApplicationDescription> fromJsonObject(const QJsonObject& jsonObj);
 
     bool isInspectable() const { return m_inspectable; }
     bool useCustomPlugin() const { return m_customPlugin; }
@@ -178,9 +179,10 @@ public:
         bool isOwner;
     };
 
-    const WindowGroupInfo getWindowGroupInfo();
-    const WindowOwnerInfo getWindowOwnerInfo();
-    const WindowClientInfo getWindowClientInfo();
+    // windowGroup is decoded once when the description is created
+    const WindowGroupInfo& getWindowGroupInfo() const { return m_windowGroupInfo; }
+    const WindowOwnerInfo& getWindowOwnerInfo() const { return m_windowOwnerInfo; }
+    const WindowClientInfo& getWindowClientInfo() const { return m_windowClientInfo; }
 
     // To support multi display
     DisplayId getDisplayAffinity() { return m_displayAffinity; }
@@ -189,6 +191,8 @@ public:
     std::string mediaPreferences() const { return m_mediaPreferences; }
 
 private:
+    void setWindowGroup(const QJsonObject& windowGroup);
+
     std::string m_id;
     std::string m_title;
     std::string m_entryPoint;
@@ -217,6 +221,9 @@ private:
     int m_heightOverride;
     QMap<int, QPair<int, int>> m_keyFilterTable;
     std::string m_groupWindowDesc;
+    WindowGroupInfo m_windowGroupInfo;
+    WindowOwnerInfo m_windowOwnerInfo;
+    WindowClientInfo m_windowClientInfo;
     bool m_doNotTrack;
     bool m_handleExitKey;
     bool m_enableBackgroundRun;
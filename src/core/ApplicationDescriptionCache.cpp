@@ -0,0 +1,97 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ApplicationDescriptionCache.h"
+
+#include "ApplicationDescription.h"
+#include "LogManager.h"
+
+ApplicationDescriptionCache::ApplicationDescriptionCache()
+    : m_hits(0)
+    , m_misses(0)
+{
+}
+
+ApplicationDescriptionCache::~ApplicationDescriptionCache()
+{
+}
+
+std::unique_ptr<ApplicationDescription> ApplicationDescriptionCache::get(const QJsonObject& appDesc)
+{
+    std::string id = appDesc["id"].toString().toStdString();
+    if (id.empty())
+        return ApplicationDescription::fromJsonObject(appDesc);
+
+    std::string version = appDesc["version"].toString().toStdString();
+    const ApplicationDescription* cached = nullptr;
+    auto it = m_entries.find(id);
+    if (it != m_entries.end() && it->second.version == version) {
+        cached = it->second.desc.get();
+        m_hits++;
+    } else {
+        cached = build(appDesc);
+        m_misses++;
+    }
+
+    // Callers adjust their descriptor per launch (e.g. displayAffinity),
+    // so always hand out a copy.
+    return std::unique_ptr<ApplicationDescription>(new ApplicationDescription(*cached));
+}
+
+std::unique_ptr<ApplicationDescription> ApplicationDescriptionCache::find(const QString& appId) const
+{
+    auto it = m_entries.find(appId.toStdString());
+    if (it == m_entries.end() || !it->second.desc)
+        return nullptr;
+
+    return std::unique_ptr<ApplicationDescription>(new ApplicationDescription(*it->second.desc));
+}
+
+void ApplicationDescriptionCache::update(const QJsonObject& appDesc, bool changed)
+{
+    if (!changed) {
+        // Every full listApps reply repeats all installed apps
+        auto it = m_entries.find(appDesc["id"].toString().toStdString());
+        if (it != m_entries.end() && it->second.desc
+            && it->second.version == appDesc["version"].toString().toStdString())
+            return;
+    }
+    build(appDesc);
+}
+
+void ApplicationDescriptionCache::remove(const QString& appId)
+{
+    m_entries.erase(appId.toStdString());
+}
+
+void ApplicationDescriptionCache::clear()
+{
+    m_entries.clear();
+}
+
+const ApplicationDescription* ApplicationDescriptionCache::build(const QJsonObject& appDesc)
+{
+    std::string id = appDesc["id"].toString().toStdString();
+    if (id.empty())
+        return nullptr;
+
+    Entry& entry = m_entries[id];
+    entry.version = appDesc["version"].toString().toStdString();
+    entry.desc = ApplicationDescription::fromJsonObject(appDesc);
+
+    LOG_DEBUG("[%s] ApplicationDescription cached; version: %s", id.c_str(), entry.version.c_str());
+    return entry.desc.get();
+}
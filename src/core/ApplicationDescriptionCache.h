@@ -0,0 +1,72 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef APPLICATIONDESCRIPTIONCACHE_H
+#define APPLICATIONDESCRIPTIONCACHE_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <QJsonObject>
+#include <QString>
+
+class ApplicationDescription;
+
+/**
+ * Keeps already built ApplicationDescriptions of installed web apps,
+ * keyed by app id and version.
+ *
+ * Entries are fed from the applicationManager listApps subscription and
+ * from launches, and dropped when the app is updated or removed.
+ * A launch of a cached app gets a copy of the cached descriptor instead of
+ * building a new one (json decoding and stat() of entry point and icon).
+ */
+class ApplicationDescriptionCache {
+public:
+    ApplicationDescriptionCache();
+    ~ApplicationDescriptionCache();
+
+    // Returns a new descriptor for appDesc; built once per id and version
+    std::unique_ptr<ApplicationDescription> get(const QJsonObject& appDesc);
+
+    // Returns a new descriptor for a cached app, nullptr if there is none
+    std::unique_ptr<ApplicationDescription> find(const QString& appId) const;
+
+    // Builds the entry for an installed app unless the cached one has the
+    // same version; |changed| rebuilds it regardless (app was reinstalled)
+    void update(const QJsonObject& appDesc, bool changed = false);
+    void remove(const QString& appId);
+    void clear();
+
+    size_t size() const { return m_entries.size(); }
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    struct Entry {
+        std::string version;
+        std::unique_ptr<ApplicationDescription> desc;
+    };
+
+    const ApplicationDescription* build(const QJsonObject& appDesc);
+
+    std::unordered_map<std::string, Entry> m_entries;
+    unsigned m_hits;
+    unsigned m_misses;
+};
+
+#endif /* APPLICATIONDESCRIPTIONCACHE_H */
@@ -0,0 +1,288 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "BackgroundLifecycle.h"
+
+#include <algorithm>
+
+#include <QList>
+#include <QStringList>
+
+#include "LaunchTimeline.h"
+#include "LogManager.h"
+#include "ProcessSampler.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+// How long a renderer is given to give memory back after a move; twice the
+// sampler's default smaps_rollup period, so that PSS is read again meanwhile
+static const int kSettleMs = 10000;
+
+BackgroundLifecycle::BackgroundLifecycle(const QString& dwellSpec)
+    : m_stats()
+{
+    // Dwell times are long; moves due within a second go together
+    m_timer.setSlack(1000);
+
+    QStringList dwells = dwellSpec.split(',', QString::SkipEmptyParts);
+    for (int i = 0; i < TierCount; i++) {
+        int index = i - TierMediaSuspended;
+        m_dwell[i] = 0;
+        if (index >= 0 && index < dwells.size() && i < TierDiscarded)
+            m_dwell[i] = std::max(dwells[index].trimmed().toInt(), 0);
+    }
+}
+
+const char* BackgroundLifecycle::tierName(Tier tier)
+{
+    switch (tier) {
+        case TierMediaSuspended: return "mediaSuspended";
+        case TierDOMSuspended: return "domSuspended";
+        case TierCompositorDeactivated: return "compositorDeactivated";
+        case TierDiscarded: return "discarded";
+        default: return "foreground";
+    }
+}
+
+BackgroundLifecycle::Tier BackgroundLifecycle::ceiling(WebAppBase* app) const
+{
+    WebPageBase* page = app->page();
+    if (!page || app->isClosing() || page->isEnableBackgroundRun()
+        || app->preloadState() != WebAppBase::NONE_PRELOAD)
+        return TierForeground;
+
+    // A keepAlive app is expected back at once
+    if (app->keepAlive())
+        return TierDOMSuspended;
+
+    return TierDiscarded;
+}
+
+void BackgroundLifecycle::backgrounded(WebAppBase* app)
+{
+    if (m_entries.contains(app) || ceiling(app) == TierForeground)
+        return;
+
+    // Hidden again before its first frame; that restore is not timed
+    m_restoring.remove(app);
+
+    Entry entry{TierForeground, 0, 0, 0, 0};
+    enter(app, entry, TierMediaSuspended);
+    m_entries.insert(app, entry);
+    startTimer();
+}
+
+bool BackgroundLifecycle::enter(WebAppBase* app, Entry& entry, Tier tier)
+{
+    if (entry.measureAt)
+        measure(entry);
+
+    WebProcessManager* processes = WebAppManager::instance()->getWebProcessManager();
+    uint32_t pid = processes ? processes->getWebProcessPID(app) : 0;
+    bool sampled = false;
+    uint64_t pssKB = rendererPss(pid, sampled);
+
+    WebPageBase* page = app->page();
+    switch (tier) {
+        case TierDOMSuspended:
+            page->expireDOMSuspendDelay();
+            break;
+        case TierCompositorDeactivated:
+            page->deactivateRendererCompositor();
+            break;
+        case TierDiscarded:
+            if (!app->discardPage())
+                return false;
+            break;
+        default:
+            // Hiding the app has suspended its media already
+            break;
+    }
+
+    LOG_INFO(MSGID_BACKGROUND_TIER, 3,
+             PMLOGKS("APP_ID", qPrintable(app->appId())),
+             PMLOGKFV("PID", "%u", pid),
+             PMLOGKS("TIER", tierName(tier)), "Renderer PSS %llu kB",
+             static_cast<unsigned long long>(pssKB));
+
+    int64_t now = LaunchTimeline::now();
+    entry.tier = tier;
+    entry.since = now;
+    entry.pid = pid;
+    entry.pssKB = sampled ? pssKB : 0;
+    entry.measureAt = sampled ? now + static_cast<int64_t>(kSettleMs) * 1000 : 0;
+    m_stats[tier].entered++;
+    return true;
+}
+
+uint64_t BackgroundLifecycle::rendererPss(uint32_t pid, bool& sampled) const
+{
+    sampled = false;
+    WebProcessManager* processes = WebAppManager::instance()->getWebProcessManager();
+    std::shared_ptr<const ProcessSnapshot> snapshot = processes ? processes->processSnapshot() : nullptr;
+    const ProcessSample* sample = snapshot && pid ? snapshot->latest(pid) : nullptr;
+    if (!sample)
+        return 0;
+
+    sampled = true;
+    return sample->pss ? sample->pss : sample->rss;
+}
+
+void BackgroundLifecycle::measure(Entry& entry)
+{
+    // A renderer that is gone has given back all it had
+    bool sampled = false;
+    uint64_t pssKB = rendererPss(entry.pid, sampled);
+
+    TierStats& stats = m_stats[entry.tier];
+    stats.measured++;
+    if (entry.pssKB > pssKB)
+        stats.savedKB += entry.pssKB - pssKB;
+    entry.measureAt = 0;
+}
+
+void BackgroundLifecycle::advanceDue()
+{
+    int64_t now = LaunchTimeline::now();
+
+    // Discarding a page may call back into WAM; don't walk the hash meanwhile
+    const QList<WebAppBase*> apps = m_entries.keys();
+    for (WebAppBase* app : apps) {
+        auto it = m_entries.find(app);
+        if (it == m_entries.end())
+            continue;
+
+        Entry& entry = it.value();
+        if (entry.measureAt && entry.measureAt <= now)
+            measure(entry);
+
+        int dwell = m_dwell[entry.tier];
+        if (!dwell || entry.tier >= ceiling(app)
+            || entry.since + static_cast<int64_t>(dwell) * 1000 > now)
+            continue;
+
+        Entry next = entry;
+        if (!enter(app, next, static_cast<Tier>(entry.tier + 1))) {
+            // Try again after another dwell time
+            next.since = now;
+        }
+        if (m_entries.contains(app))
+            m_entries.insert(app, next);
+    }
+
+    startTimer();
+}
+
+void BackgroundLifecycle::startTimer()
+{
+    m_timer.stop();
+
+    int64_t due = 0;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        const Entry& entry = it.value();
+        if (entry.measureAt && (!due || entry.measureAt < due))
+            due = entry.measureAt;
+
+        int dwell = m_dwell[entry.tier];
+        if (dwell && entry.tier < ceiling(it.key())) {
+            int64_t next = entry.since + static_cast<int64_t>(dwell) * 1000;
+            if (!due || next < due)
+                due = next;
+        }
+    }
+
+    if (!due)
+        return;
+
+    int64_t delay = std::max<int64_t>(due - LaunchTimeline::now(), 0) / 1000;
+    m_timer.start(static_cast<int>(delay), this, &BackgroundLifecycle::advanceDue);
+}
+
+void BackgroundLifecycle::restore(WebAppBase* app)
+{
+    auto it = m_entries.find(app);
+    if (it == m_entries.end())
+        return;
+
+    // Coming back before the renderer settled says nothing about the tier
+    Tier tier = it.value().tier;
+    m_entries.erase(it);
+
+    WebPageBase* page = app->page();
+    if (page && tier == TierDiscarded)
+        page->restoreDiscarded();
+    else if (page && tier == TierCompositorDeactivated)
+        page->activateRendererCompositor();
+
+    LOG_INFO(MSGID_BACKGROUND_TIER, 2,
+             PMLOGKS("APP_ID", qPrintable(app->appId())),
+             PMLOGKS("TIER", tierName(tier)), "Restore");
+
+    m_restoring.insert(app, tier);
+    app->startRestore();
+    startTimer();
+}
+
+void BackgroundLifecycle::restored(WebAppBase* app, int64_t latencyUs)
+{
+    auto it = m_restoring.find(app);
+    if (it == m_restoring.end())
+        return;
+
+    TierStats& stats = m_stats[it.value()];
+    stats.restores++;
+    stats.restoreTime += latencyUs;
+    m_restoring.erase(it);
+}
+
+void BackgroundLifecycle::appDeleted(WebAppBase* app)
+{
+    m_restoring.remove(app);
+    if (m_entries.remove(app))
+        startTimer();
+}
+
+BackgroundLifecycle::Tier BackgroundLifecycle::tier(WebAppBase* app) const
+{
+    auto it = m_entries.constFind(app);
+    return it == m_entries.constEnd() ? TierForeground : it.value().tier;
+}
+
+QJsonObject BackgroundLifecycle::stats() const
+{
+    unsigned apps[TierCount] = {};
+    for (const Entry& entry : m_entries)
+        apps[entry.tier]++;
+
+    QJsonObject stats;
+    for (int i = TierMediaSuspended; i < TierCount; i++) {
+        const TierStats& tierStats = m_stats[i];
+        QJsonObject tier;
+        tier["apps"] = static_cast<int>(apps[i]);
+        tier["entered"] = static_cast<int>(tierStats.entered);
+        tier["savedKB"] = static_cast<double>(tierStats.savedKB);
+        tier["averageSavedKB"] = tierStats.measured ? static_cast<double>(tierStats.savedKB / tierStats.measured) : 0.0;
+        tier["restores"] = static_cast<int>(tierStats.restores);
+        tier["averageRestoreMs"] = tierStats.restores ? static_cast<double>(tierStats.restoreTime / tierStats.restores / 1000) : 0.0;
+        if (i < TierDiscarded)
+            tier["dwellMs"] = m_dwell[i];
+        stats[tierName(static_cast<Tier>(i))] = tier;
+    }
+    return stats;
+}
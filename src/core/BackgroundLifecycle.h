@@ -0,0 +1,109 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef BACKGROUNDLIFECYCLE_H
+#define BACKGROUNDLIFECYCLE_H
+
+#include <stdint.h>
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+/**
+ * Moves hidden apps down an ordered set of background tiers, each
+ * holding on to less than the one before, so that many more apps can be
+ * kept "running" within a fixed amount of memory.
+ *
+ * A hidden app starts with its media suspended and, after the dwell time
+ * of each tier, has its DOM suspended, its compositor deactivated and
+ * finally its page discarded: the app keeps its entry, window, URL and
+ * launch parameters, while the web view and what the renderer holds for
+ * it are dropped, to be loaded again when the app comes back. A dwell
+ * time of 0 keeps apps in that tier. keepAlive apps stop at the DOM
+ * suspended tier; preloaded apps and pages running in the background are
+ * left alone.
+ *
+ * The renderer's PSS is compared before and after each move, once it has
+ * had time to settle, to tell what each tier saves; restore latency is
+ * timed from bringing an app back to its first frame.
+ */
+class BackgroundLifecycle {
+public:
+    enum Tier {
+        TierForeground = 0,
+        TierMediaSuspended,
+        TierDOMSuspended,
+        TierCompositorDeactivated,
+        TierDiscarded,
+        TierCount
+    };
+
+    // |dwellSpec| lists dwell times in ms for the media suspended, DOM
+    // suspended and compositor deactivated tiers, e.g. "5000,60000,600000"
+    explicit BackgroundLifecycle(const QString& dwellSpec);
+
+    static const char* tierName(Tier tier);
+
+    void backgrounded(WebAppBase* app);
+    // Brings |app| back from its tier; before a relaunch is handled too
+    void restore(WebAppBase* app);
+    // First frame of |app| since restore() came |latencyUs| after it
+    void restored(WebAppBase* app, int64_t latencyUs);
+    void appDeleted(WebAppBase* app);
+
+    Tier tier(WebAppBase* app) const;
+
+    QJsonObject stats() const;
+
+private:
+    struct Entry {
+        Tier tier;
+        int64_t since; // LaunchTimeline::now() at entering the tier
+        uint32_t pid; // renderer when entering the tier
+        uint64_t pssKB; // of the renderer when entering the tier, 0 if unknown
+        int64_t measureAt; // when to compare its PSS again, 0 if done
+    };
+
+    struct TierStats {
+        unsigned entered;
+        unsigned measured;
+        uint64_t savedKB;
+        unsigned restores;
+        int64_t restoreTime; // us, over restores
+    };
+
+    Tier ceiling(WebAppBase* app) const;
+    bool enter(WebAppBase* app, Entry& entry, Tier tier);
+    void measure(Entry& entry);
+    uint64_t rendererPss(uint32_t pid, bool& sampled) const;
+    void advanceDue();
+    void startTimer();
+
+    int m_dwell[TierCount]; // ms in a tier before the next one, 0 to stay
+    QHash<WebAppBase*, Entry> m_entries;
+    QHash<WebAppBase*, Tier> m_restoring; // tier each app is being restored from
+    OneShotTimer<BackgroundLifecycle> m_timer;
+
+    TierStats m_stats[TierCount];
+};
+
+#endif /* BACKGROUNDLIFECYCLE_H */
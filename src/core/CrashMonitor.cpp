@@ -0,0 +1,176 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "CrashMonitor.h"
+
+#include <algorithm>
+
+#include <QJsonArray>
+
+#include "LaunchTimeline.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebPageBase.h"
+
+static const int64_t kCrashWindowMs = 60000;
+// Crashes of an app within the window that get it quarantined
+static const size_t kQuarantineCrashes = 4;
+static const int kFirstBackoffMs = 1000;
+static const int kMaxBackoffMs = 30000;
+static const size_t kRecentCrashes = 16;
+
+CrashMonitor::CrashMonitor()
+    : m_crashes(0)
+    , m_reloads(0)
+    , m_delayedReloads(0)
+    , m_quarantines(0)
+{
+}
+
+CrashMonitor::Action CrashMonitor::crashed(const Crash& crash, int& delayMs)
+{
+    int64_t windowStart = crash.time - kCrashWindowMs * 1000;
+    m_crashes++;
+
+    std::deque<int64_t>& appCrashes = m_appCrashes[crash.appId];
+    while (!appCrashes.empty() && appCrashes.front() < windowStart)
+        appCrashes.pop_front();
+    appCrashes.push_back(crash.time);
+
+    size_t keyCount = 0;
+    if (!crash.key.isEmpty()) {
+        std::deque<KeyCrash>& keyCrashes = m_keyCrashes[crash.key];
+        while (!keyCrashes.empty() && keyCrashes.front().time < windowStart)
+            keyCrashes.pop_front();
+        // Every app on the renderer reports its crash
+        if (keyCrashes.empty() || !crash.pid || keyCrashes.back().pid != crash.pid)
+            keyCrashes.push_back(KeyCrash{crash.time, crash.pid});
+        keyCount = keyCrashes.size();
+    }
+
+    m_recent.push_back(crash);
+    if (m_recent.size() > kRecentCrashes)
+        m_recent.pop_front();
+
+    LOG_INFO(MSGID_WEBPROC_CRASH, 5,
+             PMLOGKS("APP_ID", qPrintable(crash.appId)),
+             PMLOGKFV("PID", "%u", crash.pid),
+             PMLOGKFV("SINCE_LAUNCH_MS", "%lld", static_cast<long long>(crash.sinceLaunch / 1000)),
+             PMLOGKFV("PSS_KB", "%llu", static_cast<unsigned long long>(crash.pssKB)),
+             PMLOGKS("VISIBLE", crash.visible ? "true" : "false"),
+             "%zu crashes of the app and %zu of %s in the last %lld s",
+             appCrashes.size(), keyCount, qPrintable(crash.key), static_cast<long long>(kCrashWindowMs / 1000));
+
+    if (m_quarantined.contains(crash.appId))
+        return Quarantine;
+
+    if (appCrashes.size() >= kQuarantineCrashes) {
+        m_quarantined.insert(crash.appId);
+        m_pendingReloads.remove(crash.appId);
+        m_quarantines++;
+        LOG_INFO(MSGID_WEBPROC_CRASH, 1, PMLOGKS("APP_ID", qPrintable(crash.appId)), "Crash loop; quarantined until closed");
+        return Quarantine;
+    }
+
+    size_t count = std::max(appCrashes.size(), keyCount);
+    delayMs = count <= 1 ? 0 : std::min(kFirstBackoffMs << std::min<size_t>(count - 2, 15), kMaxBackoffMs);
+    return Reload;
+}
+
+void CrashMonitor::scheduleReload(const QString& appId, int delayMs)
+{
+    if (delayMs <= 0) {
+        m_pendingReloads.remove(appId);
+        WebAppBase* app = WebAppManager::instance()->findAppById(appId);
+        if (app && app->page()) {
+            app->page()->reloadDefaultPage();
+            m_reloads++;
+        }
+        return;
+    }
+
+    LOG_INFO(MSGID_WEBPROC_CRASH, 1, PMLOGKS("APP_ID", qPrintable(appId)), "Reload in %d ms", delayMs);
+    m_pendingReloads.insert(appId, LaunchTimeline::now() + static_cast<int64_t>(delayMs) * 1000);
+    m_delayedReloads++;
+    startReloadTimer();
+}
+
+void CrashMonitor::startReloadTimer()
+{
+    m_reloadTimer.stop();
+    if (m_pendingReloads.isEmpty())
+        return;
+
+    int64_t due = *std::min_element(m_pendingReloads.constBegin(), m_pendingReloads.constEnd());
+    int64_t delay = std::max<int64_t>(due - LaunchTimeline::now(), 0) / 1000;
+    m_reloadTimer.start(static_cast<int>(delay), this, &CrashMonitor::reloadDue);
+}
+
+void CrashMonitor::reloadDue()
+{
+    int64_t now = LaunchTimeline::now();
+    QList<QString> due;
+    for (auto it = m_pendingReloads.constBegin(); it != m_pendingReloads.constEnd(); ++it) {
+        if (it.value() <= now)
+            due.append(it.key());
+    }
+
+    for (const QString& appId : due)
+        scheduleReload(appId, 0);
+
+    startReloadTimer();
+}
+
+void CrashMonitor::closed(const QString& appId)
+{
+    // The history stays, a relaunch that crashes again is not let off
+    m_quarantined.remove(appId);
+    if (m_pendingReloads.remove(appId))
+        startReloadTimer();
+}
+
+QJsonObject CrashMonitor::stats() const
+{
+    QJsonArray recent;
+    int64_t now = LaunchTimeline::now();
+    for (const Crash& crash : m_recent) {
+        QJsonObject entry;
+        entry["appId"] = crash.appId;
+        entry["key"] = crash.key;
+        entry["pid"] = static_cast<int>(crash.pid);
+        entry["agoMs"] = static_cast<double>((now - crash.time) / 1000);
+        entry["sinceLaunchMs"] = static_cast<double>(crash.sinceLaunch / 1000);
+        entry["pssKB"] = static_cast<double>(crash.pssKB);
+        entry["visible"] = crash.visible;
+        recent.append(entry);
+    }
+
+    QJsonArray quarantined;
+    for (const QString& appId : m_quarantined)
+        quarantined.append(appId);
+
+    QJsonObject stats;
+    stats["crashes"] = static_cast<int>(m_crashes);
+    stats["reloads"] = static_cast<int>(m_reloads);
+    stats["delayedReloads"] = static_cast<int>(m_delayedReloads);
+    stats["pendingReloads"] = m_pendingReloads.size();
+    stats["quarantines"] = static_cast<int>(m_quarantines);
+    stats["quarantined"] = quarantined;
+    stats["recent"] = recent;
+    return stats;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef CRASHMONITOR_H
+#define CRASHMONITOR_H
+
+#include <stdint.h>
+
+#include <deque>
+
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+
+#include "Timer.h"
+
+/**
+ * Crash history of apps and of their process keys, deciding how soon a
+ * crashed app may be reloaded.
+ *
+ * Crashes are counted over a sliding window, per app and per process key;
+ * a renderer crash reported by each of its apps counts once for the key.
+ * The first crash in the window reloads at once, each further one waits
+ * twice as long as the last (the larger of the app and key counts sets
+ * the wait), and an app that keeps crashing is quarantined behind the
+ * error page until it is closed. An app that crashes now and then, e.g.
+ * from a slow leak, never fills the window and is always reloaded.
+ */
+class CrashMonitor {
+public:
+    enum Action {
+        Reload,
+        Quarantine
+    };
+
+    struct Crash {
+        QString appId;
+        QString key; // process key of the renderer
+        uint32_t pid;
+        int64_t time; // LaunchTimeline::now()
+        int64_t sinceLaunch; // us
+        uint64_t pssKB; // last sampled, 0 if unknown
+        bool visible;
+    };
+
+    CrashMonitor();
+
+    // Records |crash|; for Reload, |delayMs| is how long to wait before it
+    Action crashed(const Crash& crash, int& delayMs);
+    // Reloads the default page of |appId| after |delayMs|
+    void scheduleReload(const QString& appId, int delayMs);
+    bool isQuarantined(const QString& appId) const { return m_quarantined.contains(appId); }
+    void closed(const QString& appId);
+
+    QJsonObject stats() const;
+
+private:
+    struct KeyCrash {
+        int64_t time;
+        uint32_t pid;
+    };
+
+    void reloadDue();
+    void startReloadTimer();
+
+    QHash<QString, std::deque<int64_t>> m_appCrashes;
+    QHash<QString, std::deque<KeyCrash>> m_keyCrashes;
+    QSet<QString> m_quarantined;
+    QHash<QString, int64_t> m_pendingReloads; // due time by app id
+    OneShotTimer<CrashMonitor> m_reloadTimer;
+
+    std::deque<Crash> m_recent;
+    unsigned m_crashes;
+    unsigned m_reloads;
+    unsigned m_delayedReloads;
+    unsigned m_quarantines;
+};
+
+#endif /* CRASHMONITOR_H */
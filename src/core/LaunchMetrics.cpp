@@ -0,0 +1,129 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QJsonArray>
+
+const size_t LaunchMetrics::kMaxSamples;
+
+void LaunchMetrics::Samples::add(int64_t value)
+{
+    if (m_values.size() < kMaxSamples) {
+        m_values.push_back(value);
+        return;
+    }
+
+    m_values[m_next] = value;
+    m_next = (m_next + 1) % kMaxSamples;
+}
+
+QJsonObject LaunchMetrics::Samples::toJson() const
+{
+    std::vector<int64_t> sorted(m_values);
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[rank ? rank - 1 : 0] / 1000.0;
+    };
+
+    QJsonObject obj;
+    obj["samples"] = static_cast<int>(sorted.size());
+    obj["p50"] = percentile(50);
+    obj["p95"] = percentile(95);
+    obj["p99"] = percentile(99);
+    return obj;
+}
+
+void LaunchMetrics::record(const QString& appId, const LaunchTimeline& timeline)
+{
+    if (!timeline.isStarted())
+        return;
+
+    AppMetrics& metrics = m_apps[appId];
+    LaunchTimeline::Type type = timeline.type();
+    metrics.launches[type]++;
+
+    for (int i = LaunchTimeline::LunaReceived + 1; i < LaunchTimeline::PhaseCount; ++i) {
+        int64_t elapsed = timeline.elapsed(static_cast<LaunchTimeline::Phase>(i));
+        if (elapsed >= 0)
+            metrics.phases[type][i].add(elapsed);
+    }
+}
+
+void LaunchMetrics::recordPreloadMemory(const QString& appId, const QString& level, int64_t sizeKB)
+{
+    PreloadMemory& memory = m_apps[appId].preloads[level];
+    memory.count++;
+    memory.lastKB = sizeKB;
+    memory.totalKB += sizeKB;
+}
+
+QJsonObject LaunchMetrics::appToJson(const QString& appId, const AppMetrics& metrics)
+{
+    QJsonObject obj;
+    obj["id"] = appId;
+    for (int type = 0; type < LaunchTimeline::TypeCount; ++type) {
+        if (!metrics.launches[type])
+            continue;
+
+        QJsonObject phases;
+        for (int i = LaunchTimeline::LunaReceived + 1; i < LaunchTimeline::PhaseCount; ++i) {
+            const Samples& samples = metrics.phases[type][i];
+            if (!samples.empty())
+                phases[LaunchTimeline::phaseName(static_cast<LaunchTimeline::Phase>(i))] = samples.toJson();
+        }
+
+        QJsonObject launches;
+        launches["count"] = static_cast<int>(metrics.launches[type]);
+        launches["phases"] = phases;
+        obj[LaunchTimeline::typeName(static_cast<LaunchTimeline::Type>(type))] = launches;
+    }
+
+    if (!metrics.preloads.isEmpty()) {
+        QJsonObject preloads;
+        for (auto it = metrics.preloads.constBegin(); it != metrics.preloads.constEnd(); ++it) {
+            QJsonObject memory;
+            memory["count"] = static_cast<int>(it.value().count);
+            memory["lastKB"] = static_cast<double>(it.value().lastKB);
+            memory["averageKB"] = static_cast<double>(it.value().totalKB / it.value().count);
+            preloads[it.key()] = memory;
+        }
+        obj["preload"] = preloads;
+    }
+    return obj;
+}
+
+QJsonObject LaunchMetrics::toJson(const QString& appId) const
+{
+    QJsonArray apps;
+    if (!appId.isEmpty()) {
+        auto it = m_apps.constFind(appId);
+        if (it != m_apps.constEnd())
+            apps.append(appToJson(it.key(), it.value()));
+    } else {
+        for (auto it = m_apps.constBegin(); it != m_apps.constEnd(); ++it)
+            apps.append(appToJson(it.key(), it.value()));
+    }
+
+    QJsonObject reply;
+    reply["apps"] = apps;
+    return reply;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHMETRICS_H
+#define LAUNCHMETRICS_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include "LaunchTimeline.h"
+
+/**
+ * Per app launch phase statistics, fed with finished LaunchTimelines.
+ *
+ * For each app and launch type the last kMaxSamples durations of every
+ * phase are kept; percentiles are computed when they are asked for.
+ * Next to them is the memory each preload level has cost the app, so the
+ * preloaded launch latency can be weighed against it.
+ */
+class LaunchMetrics {
+public:
+    static const size_t kMaxSamples = 128;
+
+    void record(const QString& appId, const LaunchTimeline& timeline);
+    void recordPreloadMemory(const QString& appId, const QString& level, int64_t sizeKB);
+    void clear() { m_apps.clear(); }
+
+    // Metrics of |appId|, or of all apps if |appId| is empty
+    QJsonObject toJson(const QString& appId = QString()) const;
+
+private:
+    class Samples {
+    public:
+        Samples() : m_next(0) {}
+
+        void add(int64_t value);
+        bool empty() const { return m_values.empty(); }
+        size_t size() const { return m_values.size(); }
+        // Nearest-rank percentiles of the kept samples, in milliseconds
+        QJsonObject toJson() const;
+
+    private:
+        std::vector<int64_t> m_values;
+        size_t m_next;
+    };
+
+    struct PreloadMemory {
+        PreloadMemory() : count(0), lastKB(0), totalKB(0) {}
+
+        unsigned count;
+        int64_t lastKB;
+        int64_t totalKB;
+    };
+
+    struct AppMetrics {
+        AppMetrics() : launches() {}
+
+        unsigned launches[LaunchTimeline::TypeCount];
+        Samples phases[LaunchTimeline::TypeCount][LaunchTimeline::PhaseCount];
+        // Keyed by preload level ("full", "minimal", ...)
+        QHash<QString, PreloadMemory> preloads;
+    };
+
+    static QJsonObject appToJson(const QString& appId, const AppMetrics& metrics);
+
+    QHash<QString, AppMetrics> m_apps;
+};
+
+#endif /* LAUNCHMETRICS_H */
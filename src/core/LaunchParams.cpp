@@ -0,0 +1,57 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchParams.h"
+
+#include <QJsonDocument>
+
+LaunchParams::LaunchParams()
+    : m_isNull(true)
+    , m_hasPreload(false)
+    , m_launchedHidden(false)
+    , m_keepAlive(false)
+    , m_hasDisplayAffinity(false)
+    , m_displayAffinity(kUndefinedDisplayId)
+    , m_hasContentTarget(false)
+{
+}
+
+LaunchParams::LaunchParams(const QJsonObject& params)
+    : m_params(params)
+    , m_json(QString::fromUtf8(QJsonDocument(params).toJson(QJsonDocument::Compact)))
+    , m_isNull(false)
+    , m_hasPreload(params.value("preload").isString())
+    , m_launchedHidden(params.value("launchedHidden").toBool())
+    , m_keepAlive(params.value("keepAlive").toBool())
+    , m_hasDisplayAffinity(!params.value("displayAffinity").isUndefined())
+    , m_displayAffinity(m_hasDisplayAffinity ? params.value("displayAffinity").toInt() : kUndefinedDisplayId)
+    , m_hasContentTarget(!params.value("contentTarget").isUndefined())
+{
+    // "preload" is only meaningful as a string ("full", "partial", ...)
+    if (m_hasPreload)
+        m_preload = params.value("preload").toString();
+}
+
+LaunchParams LaunchParams::fromJsonString(const QString& params)
+{
+    return LaunchParams(QJsonDocument::fromJson(params.toUtf8()).object());
+}
+
+QString LaunchParams::handledBy() const
+{
+    QJsonValue handledBy = m_params.value("handledBy");
+    return handledBy.isUndefined() ? QStringLiteral("default") : handledBy.toString();
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHPARAMS_H
+#define LAUNCHPARAMS_H
+
+#include <QJsonObject>
+#include <QString>
+
+#include "DisplayId.h"
+
+/**
+ * Launch parameters of a single launch/relaunch request.
+ *
+ * The parameters are parsed (or received as an object) once, when the
+ * request enters WAM, and the fields WAM itself looks at are decoded up
+ * front. The serialized form handed to the page is also produced only once.
+ */
+class LaunchParams {
+public:
+    LaunchParams();
+    explicit LaunchParams(const QJsonObject& params);
+
+    static LaunchParams fromJsonString(const QString& params);
+
+    // true for a default constructed instance (no request at all)
+    bool isNull() const { return m_isNull; }
+    // true when there is no request or the request carries no parameters
+    bool isEmpty() const { return m_params.isEmpty(); }
+
+    const QJsonObject& object() const { return m_params; }
+    const QString& toJson() const { return m_json; }
+
+    const QString& preload() const { return m_preload; }
+    bool hasPreload() const { return m_hasPreload; }
+    bool launchedHidden() const { return m_launchedHidden; }
+    bool keepAlive() const { return m_keepAlive; }
+
+    bool hasDisplayAffinity() const { return m_hasDisplayAffinity; }
+    DisplayId displayAffinity() const { return m_displayAffinity; }
+
+    bool hasContentTarget() const { return m_hasContentTarget; }
+    QString contentTarget() const { return m_params.value("contentTarget").toString(); }
+    QString handledBy() const;
+
+private:
+    QJsonObject m_params;
+    QString m_json;
+    QString m_preload;
+    bool m_isNull;
+    bool m_hasPreload;
+    bool m_launchedHidden;
+    bool m_keepAlive;
+    bool m_hasDisplayAffinity;
+    DisplayId m_displayAffinity;
+    bool m_hasContentTarget;
+};
+
+#endif /* LAUNCHPARAMS_H */
@@ -0,0 +1,274 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchPredictor.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTime>
+
+#include "LogManager.h"
+
+// Save a while after the last change, launches tend to come in bursts
+static const int kSaveDelayMs = 30000;
+// How much the previous app counts against the time of day
+static const double kFollowerWeight = 0.6;
+// Don't bother preloading unlikely apps
+static const double kMinScore = 0.2;
+
+const int LaunchPredictor::kHours;
+const int LaunchPredictor::kMaxApps;
+const int LaunchPredictor::kMaxFollowers;
+const unsigned LaunchPredictor::kMaxLaunches;
+
+LaunchPredictor::LaunchPredictor(const QString& modelPath)
+    : m_path(modelPath)
+    , m_preloads(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_wasted(0)
+{
+    m_saveTimer.setSlack(1000);
+    load();
+}
+
+LaunchPredictor::~LaunchPredictor()
+{
+    if (m_saveTimer.isRunning()) {
+        m_saveTimer.stop();
+        save();
+    }
+}
+
+void LaunchPredictor::recordLaunch(const QString& appId)
+{
+    if (appId.isEmpty())
+        return;
+
+    if (m_preloaded.remove(appId))
+        m_hits++;
+    else
+        m_misses++;
+
+    AppModel& model = m_apps[appId];
+    model.launches++;
+    model.hours[QTime::currentTime().hour()]++;
+    age(model);
+
+    if (!m_lastAppId.isEmpty() && m_lastAppId != appId && m_apps.contains(m_lastAppId)) {
+        AppModel& last = m_apps[m_lastAppId];
+        last.followers[appId]++;
+        if (last.followers.size() > kMaxFollowers) {
+            auto weakest = last.followers.begin();
+            for (auto it = last.followers.begin(); it != last.followers.end(); ++it) {
+                if (it.value() < weakest.value())
+                    weakest = it;
+            }
+            last.followers.erase(weakest);
+        }
+    }
+    m_lastAppId = appId;
+
+    trim();
+    scheduleSave();
+}
+
+void LaunchPredictor::remove(const QString& appId)
+{
+    if (!m_apps.remove(appId))
+        return;
+
+    for (auto it = m_apps.begin(); it != m_apps.end(); ++it)
+        it.value().followers.remove(appId);
+    if (m_lastAppId == appId)
+        m_lastAppId.clear();
+
+    scheduleSave();
+}
+
+QStringList LaunchPredictor::predict(int count, const QSet<QString>& exclude) const
+{
+    QStringList apps;
+    if (count <= 0 || m_apps.isEmpty())
+        return apps;
+
+    int hour = QTime::currentTime().hour();
+    auto hourly = [hour](const AppModel& model) {
+        // Neighbouring hours count half, so a habit at 20:55 still shows at 21:05
+        return model.hours[hour]
+            + 0.5 * (model.hours[(hour + kHours - 1) % kHours] + model.hours[(hour + 1) % kHours]);
+    };
+
+    double hourlyTotal = 0;
+    for (auto it = m_apps.constBegin(); it != m_apps.constEnd(); ++it)
+        hourlyTotal += hourly(it.value());
+
+    const AppModel* last = nullptr;
+    double followerTotal = 0;
+    auto lastIt = m_apps.constFind(m_lastAppId);
+    if (lastIt != m_apps.constEnd()) {
+        last = &lastIt.value();
+        for (unsigned launches : last->followers)
+            followerTotal += launches;
+    }
+
+    std::vector<std::pair<double, QString>> scores;
+    for (auto it = m_apps.constBegin(); it != m_apps.constEnd(); ++it) {
+        if (exclude.contains(it.key()))
+            continue;
+
+        double follower = followerTotal > 0 ? last->followers.value(it.key()) / followerTotal : 0;
+        double timeOfDay = hourlyTotal > 0 ? hourly(it.value()) / hourlyTotal : 0;
+        double score = last ? kFollowerWeight * follower + (1 - kFollowerWeight) * timeOfDay : timeOfDay;
+        if (score >= kMinScore)
+            scores.emplace_back(score, it.key());
+    }
+
+    std::sort(scores.begin(), scores.end(),
+              [](const std::pair<double, QString>& a, const std::pair<double, QString>& b) { return a.first > b.first; });
+
+    for (size_t i = 0; i < scores.size() && apps.size() < count; ++i)
+        apps.append(scores[i].second);
+    return apps;
+}
+
+void LaunchPredictor::preloaded(const QString& appId)
+{
+    m_preloaded.insert(appId);
+    m_preloads++;
+}
+
+void LaunchPredictor::closed(const QString& appId)
+{
+    if (m_preloaded.remove(appId))
+        m_wasted++;
+}
+
+QJsonObject LaunchPredictor::metrics() const
+{
+    QJsonObject obj;
+    obj["preloads"] = static_cast<int>(m_preloads);
+    obj["hits"] = static_cast<int>(m_hits);
+    obj["misses"] = static_cast<int>(m_misses);
+    obj["wasted"] = static_cast<int>(m_wasted);
+    obj["hitRate"] = m_hits + m_misses ? static_cast<double>(m_hits) / (m_hits + m_misses) : 0;
+    return obj;
+}
+
+void LaunchPredictor::age(AppModel& model)
+{
+    if (model.launches < kMaxLaunches)
+        return;
+
+    // Halve the counts so that old habits fade out
+    model.launches /= 2;
+    for (int i = 0; i < kHours; ++i)
+        model.hours[i] /= 2;
+    for (auto it = model.followers.begin(); it != model.followers.end(); ++it)
+        it.value() /= 2;
+}
+
+void LaunchPredictor::trim()
+{
+    while (m_apps.size() > kMaxApps) {
+        auto weakest = m_apps.end();
+        for (auto it = m_apps.begin(); it != m_apps.end(); ++it) {
+            if (it.key() == m_lastAppId)
+                continue;
+            if (weakest == m_apps.end() || it.value().launches < weakest.value().launches)
+                weakest = it;
+        }
+        remove(weakest.key());
+    }
+}
+
+void LaunchPredictor::load()
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QJsonObject model = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+
+    QJsonObject apps = model["apps"].toObject();
+    for (auto it = apps.constBegin(); it != apps.constEnd(); ++it) {
+        QJsonObject app = it.value().toObject();
+        AppModel& appModel = m_apps[it.key()];
+
+        QJsonArray hours = app["hours"].toArray();
+        for (int i = 0; i < kHours && i < hours.size(); ++i) {
+            appModel.hours[i] = static_cast<unsigned>(hours[i].toInt());
+            appModel.launches += appModel.hours[i];
+        }
+
+        QJsonObject followers = app["followers"].toObject();
+        for (auto f = followers.constBegin(); f != followers.constEnd(); ++f)
+            appModel.followers.insert(f.key(), static_cast<unsigned>(f.value().toInt()));
+    }
+    m_lastAppId = model["lastAppId"].toString();
+
+    LOG_DEBUG("LaunchPredictor: loaded %d apps from %s", m_apps.size(), qPrintable(m_path));
+}
+
+void LaunchPredictor::scheduleSave()
+{
+    if (!m_saveTimer.isRunning())
+        m_saveTimer.start(kSaveDelayMs, this, &LaunchPredictor::save);
+}
+
+void LaunchPredictor::save()
+{
+    QJsonObject apps;
+    for (auto it = m_apps.constBegin(); it != m_apps.constEnd(); ++it) {
+        QJsonArray hours;
+        for (int i = 0; i < kHours; ++i)
+            hours.append(static_cast<int>(it.value().hours[i]));
+
+        QJsonObject followers;
+        for (auto f = it.value().followers.constBegin(); f != it.value().followers.constEnd(); ++f)
+            followers[f.key()] = static_cast<int>(f.value());
+
+        QJsonObject app;
+        app["hours"] = hours;
+        app["followers"] = followers;
+        apps[it.key()] = app;
+    }
+
+    QJsonObject model;
+    model["apps"] = apps;
+    model["lastAppId"] = m_lastAppId;
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    // Written to a temporary file and renamed, so a crash or power loss
+    // mid-write leaves the previous model in place
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOG_WARNING(MSGID_WAM_DEBUG, 0, "LaunchPredictor: failed to save %s", qPrintable(m_path));
+        return;
+    }
+    file.write(QJsonDocument(model).toJson(QJsonDocument::Compact));
+    if (!file.commit())
+        LOG_WARNING(MSGID_WAM_DEBUG, 0, "LaunchPredictor: failed to save %s", qPrintable(m_path));
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHPREDICTOR_H
+#define LAUNCHPREDICTOR_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include "Timer.h"
+
+/**
+ * Learns which apps the user launches, and predicts the next ones.
+ *
+ * The model keeps, per app, its launches per hour of the day and the apps
+ * launched right after it. It is small (kMaxApps apps, kMaxFollowers
+ * followers each) and saved to disk a while after it changes.
+ *
+ * Preloads made for a prediction are tracked to tell how often they are
+ * used (hits) against launches they did not cover (misses) and preloads
+ * that were closed unused (wasted).
+ */
+class LaunchPredictor {
+public:
+    explicit LaunchPredictor(const QString& modelPath);
+    ~LaunchPredictor();
+
+    // A user visible launch or relaunch of |appId|
+    void recordLaunch(const QString& appId);
+    // |appId| was uninstalled
+    void remove(const QString& appId);
+
+    // Up to |count| likely next apps, most likely first
+    QStringList predict(int count, const QSet<QString>& exclude) const;
+
+    void preloaded(const QString& appId);
+    void closed(const QString& appId);
+    int preloadedCount() const { return m_preloaded.size(); }
+
+    QJsonObject metrics() const;
+
+private:
+    static const int kHours = 24;
+    static const int kMaxApps = 64;
+    static const int kMaxFollowers = 8;
+    static const unsigned kMaxLaunches = 1024;
+
+    struct AppModel {
+        AppModel() : launches(0), hours() {}
+
+        unsigned launches;
+        unsigned hours[kHours];
+        QHash<QString, unsigned> followers;
+    };
+
+    void age(AppModel& model);
+    void trim();
+
+    void load();
+    void scheduleSave();
+    void save();
+
+    QString m_path;
+    QHash<QString, AppModel> m_apps;
+    QString m_lastAppId;
+
+    QSet<QString> m_preloaded;
+    unsigned m_preloads;
+    unsigned m_hits;
+    unsigned m_misses;
+    unsigned m_wasted;
+
+    OneShotTimer<LaunchPredictor> m_saveTimer;
+};
+
+#endif /* LAUNCHPREDICTOR_H */
@@ -0,0 +1,82 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LaunchTimeline.h"
+
+#include <glib.h>
+
+LaunchTimeline::LaunchTimeline()
+    : m_type(Cold)
+    , m_marks()
+{
+}
+
+int64_t LaunchTimeline::now()
+{
+    return g_get_monotonic_time();
+}
+
+const char* LaunchTimeline::phaseName(Phase phase)
+{
+    switch (phase) {
+        case LunaReceived: return "lunaReceived";
+        case DescriptionParsed: return "descriptionParsed";
+        case WebAppCreated: return "webAppCreated";
+        case WebPageCreated: return "webPageCreated";
+        case LoadRequested: return "loadRequested";
+        case RenderProcessCreated: return "renderProcessCreated";
+        case NavigationStarted: return "navigationStarted";
+        case VisuallyCommitted: return "visuallyCommitted";
+        case FirstFocusIn: return "firstFocusIn";
+        case LastFrameSwapped: return "lastFrameSwapped";
+        default: return "unknown";
+    }
+}
+
+const char* LaunchTimeline::typeName(Type type)
+{
+    switch (type) {
+        case Cold: return "cold";
+        case Warm: return "warm";
+        case Preloaded: return "preloaded";
+        case Relaunch: return "relaunch";
+        default: return "unknown";
+    }
+}
+
+void LaunchTimeline::start()
+{
+    for (int i = 0; i < PhaseCount; ++i)
+        m_marks[i] = 0;
+    m_marks[LunaReceived] = now();
+}
+
+void LaunchTimeline::mark(Phase phase)
+{
+    if (!isStarted())
+        return;
+
+    if (!m_marks[phase] || phase == LastFrameSwapped)
+        m_marks[phase] = now();
+}
+
+int64_t LaunchTimeline::elapsed(Phase phase) const
+{
+    if (!isStarted() || !m_marks[phase])
+        return -1;
+
+    return m_marks[phase] - m_marks[LunaReceived];
+}
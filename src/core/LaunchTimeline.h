@@ -0,0 +1,77 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHTIMELINE_H
+#define LAUNCHTIMELINE_H
+
+#include <stdint.h>
+
+/**
+ * Monotonic timestamps of the phases of a single app launch, starting
+ * when the launch request is received from the bus.
+ *
+ * Each phase keeps the time it was first reached, except LastFrameSwapped
+ * which is moved forward on every swap until the launch is finished.
+ */
+class LaunchTimeline {
+public:
+    enum Phase {
+        LunaReceived = 0,
+        DescriptionParsed,
+        WebAppCreated,
+        WebPageCreated,
+        LoadRequested,
+        RenderProcessCreated,
+        NavigationStarted,
+        VisuallyCommitted,
+        FirstFocusIn,
+        LastFrameSwapped,
+        PhaseCount
+    };
+
+    enum Type {
+        Cold = 0,   // first launch of the app since WAM started
+        Warm,       // app was launched and closed before
+        Preloaded,  // app was running hidden as preloaded
+        Relaunch,   // app was already running
+        TypeCount
+    };
+
+    LaunchTimeline();
+
+    // Monotonic clock in microseconds
+    static int64_t now();
+    static const char* phaseName(Phase phase);
+    static const char* typeName(Type type);
+
+    // Clears all phases and marks LunaReceived
+    void start();
+    bool isStarted() const { return m_marks[LunaReceived] != 0; }
+
+    void mark(Phase phase);
+    bool hasMark(Phase phase) const { return m_marks[phase] != 0; }
+    // Microseconds from LunaReceived to |phase|, -1 if not reached
+    int64_t elapsed(Phase phase) const;
+
+    Type type() const { return m_type; }
+    void setType(Type type) { m_type = type; }
+
+private:
+    Type m_type;
+    int64_t m_marks[PhaseCount];
+};
+
+#endif /* LAUNCHTIMELINE_H */
@@ -0,0 +1,75 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LocalMemoryMonitor.h"
+
+#include <QFile>
+
+#include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerUtils.h"
+
+LocalMemoryMonitor::LocalMemoryMonitor(int intervalMs, const QString& levelFile)
+    : m_levelFile(levelFile)
+    , m_level(QStringLiteral("normal"))
+{
+    m_pollTimer.start(intervalMs, this, &LocalMemoryMonitor::poll);
+}
+
+void LocalMemoryMonitor::poll()
+{
+    QString level = readLevel();
+    if (level == m_level)
+        return;
+
+    LOG_INFO(MSGID_NOTIFY_MEMORY_STATE, 2, PMLOGKS("State", qPrintable(level)), PMLOGKS("FROM", qPrintable(m_level)), "Local memory monitor");
+    m_level = level;
+    thresholdChanged(level);
+}
+
+void LocalMemoryMonitor::thresholdChanged(const QString& level)
+{
+    WebAppManager::instance()->onMemoryThresholdChanged(level);
+}
+
+QString LocalMemoryMonitor::readLevel() const
+{
+    if (!m_levelFile.isEmpty()) {
+        QFile file(m_levelFile);
+        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            QString level = QString::fromUtf8(file.readAll()).trimmed();
+            if (level == "normal" || level == "medium" || level == "low" || level == "critical")
+                return level;
+        }
+    }
+
+    long total = WebAppManagerUtils::getMemTotal();
+    long available = WebAppManagerUtils::getMemAvailable();
+    if (total <= 0 || available < 0)
+        return m_level;
+    return levelFor(available, total);
+}
+
+QString LocalMemoryMonitor::levelFor(long availableKB, long totalKB)
+{
+    if (availableKB < totalKB / 20)
+        return QStringLiteral("critical");
+    if (availableKB < totalKB / 10)
+        return QStringLiteral("low");
+    if (availableKB < totalKB / 5)
+        return QStringLiteral("medium");
+    return QStringLiteral("normal");
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LOCALMEMORYMONITOR_H
+#define LOCALMEMORYMONITOR_H
+
+#include <QString>
+
+#include "Timer.h"
+
+/**
+ * Stand-in for the thresholdChanged signal of the memory manager, for
+ * boxes that don't run one.
+ *
+ * Polls /proc/meminfo and reports "normal", "medium", "low" or "critical"
+ * as MemAvailable drops below 20%, 10% and 5% of MemTotal. If
+ * |levelFile| is given and holds one of those words, that level is
+ * reported instead, so that pressure can be driven by hand.
+ */
+class LocalMemoryMonitor {
+public:
+    LocalMemoryMonitor(int intervalMs, const QString& levelFile);
+    virtual ~LocalMemoryMonitor() {}
+
+    QString level() const { return m_level; }
+
+    // Level for |availableKB| of MemAvailable out of |totalKB| of MemTotal
+    static QString levelFor(long availableKB, long totalKB);
+
+protected:
+    // Passes a level that has changed on to WebAppManager
+    virtual void thresholdChanged(const QString& level);
+
+private:
+    void poll();
+    QString readLevel() const;
+
+    QString m_levelFile;
+    QString m_level;
+    RepeatingTimer<LocalMemoryMonitor> m_pollTimer;
+};
+
+#endif /* LOCALMEMORYMONITOR_H */
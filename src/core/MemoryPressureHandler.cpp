@@ -0,0 +1,328 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "MemoryPressureHandler.h"
+
+#include <vector>
+
+#include "LaunchTimeline.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppRegistry.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+// How long the reported level has to stay below the current one before we follow it down
+static const int kRelaxDwellMs = 5000;
+
+static int stageDelayMs(MemoryPressureHandler::Level level)
+{
+    switch (level) {
+        case MemoryPressureHandler::LevelMedium: return 3000;
+        case MemoryPressureHandler::LevelLow: return 1000;
+        default: return 0;
+    }
+}
+
+static MemoryPressureHandler::Stage lastStage(MemoryPressureHandler::Level level)
+{
+    switch (level) {
+        case MemoryPressureHandler::LevelMedium: return MemoryPressureHandler::StageSuspendHidden;
+        case MemoryPressureHandler::LevelLow: return MemoryPressureHandler::StageDiscardPreload;
+        case MemoryPressureHandler::LevelCritical: return MemoryPressureHandler::StageEvict;
+        default: return MemoryPressureHandler::StageNone;
+    }
+}
+
+static webos::WebViewBase::MemoryPressureLevel webViewPressure(MemoryPressureHandler::Level level)
+{
+    switch (level) {
+        case MemoryPressureHandler::LevelNormal: return webos::WebViewBase::MEMORY_PRESSURE_NONE;
+        case MemoryPressureHandler::LevelMedium: return webos::WebViewBase::MEMORY_PRESSURE_LOW;
+        default: return webos::WebViewBase::MEMORY_PRESSURE_CRITICAL;
+    }
+}
+
+MemoryPressureHandler::MemoryPressureHandler()
+    : m_reportedLevel(LevelNormal)
+    , m_level(LevelNormal)
+    , m_belowSince(0)
+    , m_stage(StageNone)
+    , m_resolvingStage(StageNone)
+    , m_episodeStart(0)
+    , m_stageStats()
+    , m_episodes(0)
+    , m_escalations(0)
+    , m_longestEpisode(0)
+{
+    m_relaxTimer.setSlack(1000);
+}
+
+MemoryPressureHandler::Level MemoryPressureHandler::levelFromName(const QString& name)
+{
+    if (name == "medium")
+        return LevelMedium;
+    if (name == "low")
+        return LevelLow;
+    if (name == "critical")
+        return LevelCritical;
+    return LevelNormal;
+}
+
+const char* MemoryPressureHandler::levelName(Level level)
+{
+    switch (level) {
+        case LevelMedium: return "medium";
+        case LevelLow: return "low";
+        case LevelCritical: return "critical";
+        default: return "normal";
+    }
+}
+
+const char* MemoryPressureHandler::stageName(Stage stage)
+{
+    switch (stage) {
+        case StageTrimForeground: return "trimForeground";
+        case StageNotifyBackground: return "notifyBackground";
+        case StageSuspendHidden: return "suspendHidden";
+        case StageDeactivateCompositor: return "deactivateCompositor";
+        case StageDiscardPreload: return "discardPreload";
+        case StageEvict: return "evict";
+        default: return "none";
+    }
+}
+
+void MemoryPressureHandler::setLevel(Level level)
+{
+    m_reportedLevel = level;
+    if (level > m_level) {
+        escalate(level);
+        return;
+    }
+
+    if (level == m_level) {
+        // Pressure is back where it was; a pending drop no longer holds
+        m_belowSince = 0;
+        m_relaxTimer.stop();
+        return;
+    }
+
+    // Only the first report below the level starts the dwell
+    if (!m_belowSince)
+        m_belowSince = LaunchTimeline::now();
+    relax();
+}
+
+void MemoryPressureHandler::escalate(Level level)
+{
+    Level previous = m_level;
+    m_level = level;
+    m_belowSince = 0;
+    m_relaxTimer.stop();
+
+    if (previous == LevelNormal) {
+        m_episodes++;
+        m_episodeStart = LaunchTimeline::now();
+        m_stage = StageNone;
+        m_resolvingStage = StageNone;
+        // Suspend delays stretched for quick returns are not worth the memory
+        for (WebAppBase* app : WebAppManager::instance()->appRegistry()) {
+            if (app->page() && !app->isActivated())
+                app->page()->expireLearnedSuspendDelay();
+        }
+    } else {
+        m_escalations++;
+        // Pages already told about pressure hear about the new level too
+        if (webViewPressure(previous) != webViewPressure(level)) {
+            if (m_stage >= StageTrimForeground)
+                notifyPages(true);
+            if (m_stage >= StageNotifyBackground)
+                notifyPages(false);
+        }
+    }
+
+    LOG_INFO(MSGID_NOTIFY_MEMORY_STATE, 2, PMLOGKS("State", levelName(level)), PMLOGKS("FROM", levelName(previous)), "Memory pressure raised at stage %s", stageName(m_stage));
+
+    m_stageTimer.stop();
+    runNextStage();
+}
+
+void MemoryPressureHandler::relax()
+{
+    if (m_reportedLevel >= m_level)
+        return;
+
+    int64_t dwell = (LaunchTimeline::now() - m_belowSince) / 1000;
+    if (dwell < kRelaxDwellMs) {
+        if (!m_relaxTimer.isRunning())
+            m_relaxTimer.start(kRelaxDwellMs - static_cast<int>(dwell), this, &MemoryPressureHandler::relax);
+        return;
+    }
+
+    Level previous = m_level;
+    m_level = static_cast<Level>(m_level - 1);
+    // The next step down waits a dwell of its own
+    m_belowSince = m_reportedLevel < m_level ? LaunchTimeline::now() : 0;
+    LOG_INFO(MSGID_NOTIFY_MEMORY_STATE, 2, PMLOGKS("State", levelName(m_level)), PMLOGKS("FROM", levelName(previous)), "Memory pressure relaxed");
+
+    if (m_level == LevelNormal) {
+        endEpisode();
+        return;
+    }
+
+    if (m_reportedLevel < m_level)
+        m_relaxTimer.start(kRelaxDwellMs, this, &MemoryPressureHandler::relax);
+}
+
+void MemoryPressureHandler::runNextStage()
+{
+    Stage last = lastStage(m_level);
+    int delay = stageDelayMs(m_level);
+    while (m_stage < last) {
+        m_stage = static_cast<Stage>(m_stage + 1);
+        bool acted = runStage(m_stage);
+        LOG_INFO(MSGID_NOTIFY_MEMORY_STATE, 2, PMLOGKS("State", levelName(m_level)), PMLOGKS("STAGE", stageName(m_stage)), "%s", acted ? "Applied" : "Nothing to do");
+        if (!acted)
+            continue;
+
+        m_stageStats[m_stage].runs++;
+        m_resolvingStage = m_stage;
+        // Give it time to take effect before going further
+        if (delay)
+            break;
+    }
+
+    if (m_stage < last)
+        m_stageTimer.start(delay, this, &MemoryPressureHandler::runNextStage);
+}
+
+bool MemoryPressureHandler::runStage(Stage stage)
+{
+    WebAppManager* manager = WebAppManager::instance();
+    bool acted = false;
+
+    switch (stage) {
+        case StageTrimForeground:
+            return notifyPages(true);
+        case StageNotifyBackground:
+            return notifyPages(false);
+        case StageSuspendHidden:
+            for (WebAppBase* app : manager->appRegistry()) {
+                if (app->page() && !app->isActivated() && app->page()->expireDOMSuspendDelay())
+                    acted = true;
+            }
+            return acted;
+        case StageDeactivateCompositor:
+            for (WebAppBase* app : manager->appRegistry()) {
+                // Preloads keep the compositor state their preload level gave them
+                if (!app->page() || app->isActivated() || app->isClosing()
+                    || app->preloadState() != WebAppBase::NONE_PRELOAD
+                    || !m_compositorDeactivated.insert(app).second)
+                    continue;
+                app->page()->deactivateRendererCompositor();
+                acted = true;
+            }
+            return acted;
+        case StageDiscardPreload: {
+            std::vector<WebAppBase*> preloads;
+            for (WebAppBase* app : manager->appRegistry()) {
+                if (app->page() && !app->isClosing() && app->preloadState() != WebAppBase::NONE_PRELOAD)
+                    preloads.push_back(app);
+            }
+            if (preloads.empty())
+                return false;
+
+            for (WebAppBase* app : preloads)
+                manager->closeAppInternal(app);
+            return true;
+        }
+        case StageEvict:
+            return manager->evictBackgroundApps(levelName(m_level));
+        default:
+            return false;
+    }
+}
+
+bool MemoryPressureHandler::notifyPages(bool activated)
+{
+    webos::WebViewBase::MemoryPressureLevel pressure = webViewPressure(m_level);
+    bool notified = false;
+    for (WebAppBase* app : WebAppManager::instance()->appRegistry()) {
+        if (!app->page() || app->isClosing() || app->isActivated() != activated)
+            continue;
+        // Preloaded apps are about to be discarded if pressure is critical
+        if (app->page()->isPreload() && pressure == webos::WebViewBase::MEMORY_PRESSURE_CRITICAL)
+            continue;
+        app->page()->notifyMemoryPressure(pressure);
+        notified = true;
+    }
+    return notified;
+}
+
+void MemoryPressureHandler::endEpisode()
+{
+    m_stageTimer.stop();
+    m_relaxTimer.stop();
+
+    int64_t duration = LaunchTimeline::now() - m_episodeStart;
+    StageStats& resolver = m_stageStats[m_resolvingStage];
+    resolver.resolved++;
+    resolver.resolveTime += duration;
+    if (duration > m_longestEpisode)
+        m_longestEpisode = duration;
+
+    LOG_INFO(MSGID_NOTIFY_MEMORY_STATE, 2, PMLOGKS("STAGE", stageName(m_resolvingStage)), PMLOGKFV("DURATION_MS", "%lld", static_cast<long long>(duration / 1000)), "Memory pressure resolved");
+    m_stage = StageNone;
+    m_resolvingStage = StageNone;
+
+    WebAppManager::instance()->notifyMemoryPressure(webos::WebViewBase::MEMORY_PRESSURE_NONE);
+}
+
+void MemoryPressureHandler::appForegrounded(WebAppBase* app)
+{
+    if (m_compositorDeactivated.erase(app) && app->page())
+        app->page()->activateRendererCompositor();
+}
+
+void MemoryPressureHandler::appDeleted(WebAppBase* app)
+{
+    m_compositorDeactivated.erase(app);
+}
+
+QJsonObject MemoryPressureHandler::stats() const
+{
+    QJsonObject stages;
+    for (int i = StageNone; i < StageCount; i++) {
+        const StageStats& stats = m_stageStats[i];
+        QJsonObject stage;
+        stage["runs"] = static_cast<int>(stats.runs);
+        stage["resolved"] = static_cast<int>(stats.resolved);
+        stage["averageResolveMs"] = stats.resolved ? static_cast<double>(stats.resolveTime / stats.resolved / 1000) : 0.0;
+        stages[stageName(static_cast<Stage>(i))] = stage;
+    }
+
+    QJsonObject stats;
+    stats["level"] = levelName(m_level);
+    stats["reportedLevel"] = levelName(m_reportedLevel);
+    stats["stage"] = stageName(m_stage);
+    stats["episodes"] = static_cast<int>(m_episodes);
+    stats["escalations"] = static_cast<int>(m_escalations);
+    stats["longestEpisodeMs"] = static_cast<double>(m_longestEpisode / 1000);
+    stats["stages"] = stages;
+    return stats;
+}
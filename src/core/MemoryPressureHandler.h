@@ -0,0 +1,114 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef MEMORYPRESSUREHANDLER_H
+#define MEMORYPRESSUREHANDLER_H
+
+#include <set>
+#include <stdint.h>
+
+#include <QJsonObject>
+#include <QString>
+
+#include "Timer.h"
+
+class WebAppBase;
+
+/**
+ * Turns memory manager levels into a graded response.
+ *
+ * A rise in level is acted on at once; a drop is only followed one level
+ * at a time, after the reported level has stayed below the current one
+ * for a minimum dwell time, so that a level flapping around a threshold
+ * does not restart the response over and over.
+ *
+ * While pressure lasts, stages are run cheapest first, waiting between
+ * them for the previous one to take effect (less the higher the level).
+ * Stages that find nothing to act on are skipped. How deep it may go
+ * depends on the level: medium stops after suspending hidden pages, low
+ * after discarding preloads, and only critical closes background apps.
+ *
+ * An episode lasts from leaving normal to coming back to it, and is
+ * credited to the last stage that acted on something.
+ */
+class MemoryPressureHandler {
+public:
+    enum Level {
+        LevelNormal = 0,
+        LevelMedium,
+        LevelLow,
+        LevelCritical
+    };
+
+    enum Stage {
+        StageNone = 0,
+        StageTrimForeground, // foreground pages drop their caches
+        StageNotifyBackground, // background pages do the same
+        StageSuspendHidden, // hidden pages skip what is left of their DOM suspend delay
+        StageDeactivateCompositor, // hidden pages give up their compositor
+        StageDiscardPreload, // preloaded apps are closed
+        StageEvict, // background apps are closed, least recently used first
+        StageCount
+    };
+
+    MemoryPressureHandler();
+
+    static Level levelFromName(const QString& name);
+    static const char* levelName(Level level);
+    static const char* stageName(Stage stage);
+
+    // |level| as reported by the memory manager
+    void setLevel(Level level);
+    Level level() const { return m_level; }
+
+    // |app| is coming to the foreground; gives back what an episode took from it
+    void appForegrounded(WebAppBase* app);
+    void appDeleted(WebAppBase* app);
+
+    QJsonObject stats() const;
+
+private:
+    struct StageStats {
+        unsigned runs;
+        unsigned resolved;
+        int64_t resolveTime; // us, summed over the episodes it resolved
+    };
+
+    void escalate(Level level);
+    void relax();
+    void runNextStage();
+    bool runStage(Stage stage);
+    bool notifyPages(bool activated);
+    void endEpisode();
+
+    Level m_reportedLevel;
+    Level m_level;
+    int64_t m_belowSince; // when the reported level dropped below m_level, 0 if it is not below
+    Stage m_stage;
+    Stage m_resolvingStage; // last stage of the episode that found something to do
+    int64_t m_episodeStart;
+    std::set<WebAppBase*> m_compositorDeactivated;
+    OneShotTimer<MemoryPressureHandler> m_stageTimer;
+    OneShotTimer<MemoryPressureHandler> m_relaxTimer;
+
+    StageStats m_stageStats[StageCount];
+    unsigned m_episodes;
+    unsigned m_escalations;
+    int64_t m_longestEpisode;
+};
+
+#endif /* MEMORYPRESSUREHANDLER_H */
@@ -0,0 +1,207 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "OomScoreManager.h"
+
+#include <sys/stat.h>
+
+#include <QSet>
+
+#include "ApplicationDescription.h"
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerUtils.h"
+#include "WebAppRegistry.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+// Lowering a score takes CAP_SYS_RESOURCE, so the ladder starts at 0
+static const int kScoreAdj[OomScoreManager::TierCount] = {
+    0, // foreground
+    100, // overlay
+    300, // keepAlive
+    600, // hidden
+    800, // preloaded
+    1000, // empty
+};
+
+OomScoreManager::OomScoreManager(const QString& procRoot)
+    : m_procRoot(procRoot)
+    , m_updates(0)
+    , m_writes(0)
+    , m_failures(0)
+    , m_crashes()
+{
+}
+
+const char* OomScoreManager::tierName(Tier tier)
+{
+    switch (tier) {
+        case TierForeground: return "foreground";
+        case TierOverlay: return "overlay";
+        case TierKeepAlive: return "keepAlive";
+        case TierHidden: return "hidden";
+        case TierPreloaded: return "preloaded";
+        case TierEmpty: return "empty";
+        default: return "unknown";
+    }
+}
+
+int OomScoreManager::scoreAdj(Tier tier)
+{
+    return tier < TierCount ? kScoreAdj[tier] : kScoreAdj[TierEmpty];
+}
+
+void OomScoreManager::schedule(uint32_t createdPid)
+{
+    if (createdPid)
+        m_tiers.remove(createdPid);
+
+    if (!m_updateTimer.isRunning())
+        m_updateTimer.start(0, this, &OomScoreManager::update);
+}
+
+void OomScoreManager::update()
+{
+    WebAppManager* manager = WebAppManager::instance();
+    WebProcessManager* processes = manager->getWebProcessManager();
+    if (!processes)
+        return;
+
+    std::vector<AppTier> apps;
+    for (WebAppBase* app : manager->appRegistry()) {
+        if (!app->page() || app->isClosing())
+            continue;
+
+        uint32_t pid = processes->getWebProcessPID(app);
+        if (!pid)
+            continue;
+
+        Tier tier;
+        if (app->preloadState() != WebAppBase::NONE_PRELOAD)
+            tier = TierPreloaded;
+        else if (app->isActivated())
+            tier = app->getAppDescription()->defaultWindowType() == "overlay" ? TierOverlay : TierForeground;
+        else if (app->keepAlive())
+            tier = TierKeepAlive;
+        else
+            tier = TierHidden;
+
+        apps.push_back(AppTier{pid, processes->getProcessKey(app->getAppDescription()), tier});
+    }
+
+    apply(rendererTiers(apps));
+}
+
+QHash<uint32_t, OomScoreManager::Tier> OomScoreManager::rendererTiers(const std::vector<AppTier>& apps)
+{
+    QHash<uint32_t, Tier> tiers;
+    QHash<uint32_t, QString> keys;
+    QSet<QString> foregroundKeys;
+    for (const AppTier& app : apps) {
+        keys.insert(app.pid, app.key);
+        if (app.tier == TierForeground)
+            foregroundKeys.insert(app.key);
+
+        auto it = tiers.find(app.pid);
+        if (it == tiers.end())
+            tiers.insert(app.pid, app.tier);
+        else if (app.tier < it.value())
+            it.value() = app.tier;
+    }
+
+    // Every app shares the "system" key, only real groups are shared
+    for (auto it = tiers.begin(); it != tiers.end(); ++it) {
+        const QString& key = keys.value(it.key());
+        if (it.value() > TierKeepAlive && key != QStringLiteral("system") && foregroundKeys.contains(key))
+            it.value() = TierKeepAlive;
+    }
+    return tiers;
+}
+
+void OomScoreManager::apply(QHash<uint32_t, Tier> tiers)
+{
+    // Renderers left without apps stay around until they are reclaimed
+    for (auto it = m_tiers.constBegin(); it != m_tiers.constEnd(); ++it) {
+        if (!tiers.contains(it.key()) && isAlive(it.key()))
+            tiers.insert(it.key(), TierEmpty);
+    }
+
+    for (auto it = tiers.constBegin(); it != tiers.constEnd(); ++it) {
+        if (m_tiers.value(it.key(), TierCount) == it.value())
+            continue;
+
+        if (writeScoreAdj(it.key(), it.value()))
+            m_writes++;
+        else
+            m_failures++;
+    }
+
+    m_tiers = tiers;
+    m_updates++;
+}
+
+bool OomScoreManager::isAlive(uint32_t pid) const
+{
+    struct stat st;
+    return stat(QStringLiteral("%1/%2").arg(m_procRoot).arg(pid).toStdString().c_str(), &st) == 0;
+}
+
+bool OomScoreManager::writeScoreAdj(uint32_t pid, Tier tier)
+{
+    std::string path = QStringLiteral("%1/%2/oom_score_adj").arg(m_procRoot).arg(pid).toStdString();
+    bool written = WebAppManagerUtils::writeFile(path, std::to_string(scoreAdj(tier)));
+    LOG_DEBUG("oom_score_adj of web process %u: %d (%s)%s", pid, scoreAdj(tier), tierName(tier), written ? "" : "; refused");
+    return written;
+}
+
+void OomScoreManager::processCrashed(uint32_t pid)
+{
+    auto it = m_tiers.find(pid);
+    if (it == m_tiers.end()) {
+        // Either already counted for another app on it, or never scored
+        return;
+    }
+
+    m_crashes[it.value()]++;
+    LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKFV("PID", "%u", pid), PMLOGKS("OOM_TIER", tierName(it.value())), "oom_score_adj %d", scoreAdj(it.value()));
+    m_tiers.erase(it);
+}
+
+QJsonObject OomScoreManager::stats() const
+{
+    int counts[TierCount] = {};
+    for (Tier tier : m_tiers)
+        counts[tier]++;
+
+    QJsonObject renderers;
+    QJsonObject crashes;
+    for (int i = 0; i < TierCount; i++) {
+        renderers[tierName(static_cast<Tier>(i))] = counts[i];
+        crashes[tierName(static_cast<Tier>(i))] = static_cast<int>(m_crashes[i]);
+    }
+
+    QJsonObject stats;
+    stats["procRoot"] = m_procRoot;
+    stats["updates"] = static_cast<int>(m_updates);
+    stats["writes"] = static_cast<int>(m_writes);
+    stats["failures"] = static_cast<int>(m_failures);
+    stats["renderers"] = renderers;
+    stats["crashes"] = crashes;
+    return stats;
+}
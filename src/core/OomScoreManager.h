@@ -0,0 +1,94 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef OOMSCOREMANAGER_H
+#define OOMSCOREMANAGER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include "Timer.h"
+
+/**
+ * Writes oom_score_adj of every renderer from a ladder, so that the
+ * kernel OOM killer goes for idle preloads before anything in sight.
+ *
+ * A renderer takes the best tier among its apps: a renderer shared by
+ * a foreground app and hidden ones is a foreground renderer. Renderers
+ * of a process key (other than "system") whose foreground app runs in
+ * another renderer are held at keepAlive at worst. Renderers that still
+ * run with no app left on them (e.g. waiting to be reclaimed) come last.
+ *
+ * |procRoot| stands for /proc, so that the ladder can be run against
+ * a directory tree of its own.
+ */
+class OomScoreManager {
+public:
+    enum Tier {
+        TierForeground = 0,
+        TierOverlay, // a visible overlay window
+        TierKeepAlive,
+        TierHidden,
+        TierPreloaded,
+        TierEmpty, // no live app
+        TierCount
+    };
+
+    struct AppTier {
+        uint32_t pid; // of its renderer
+        QString key; // process key
+        Tier tier; // of the app by itself
+    };
+
+    explicit OomScoreManager(const QString& procRoot);
+
+    static const char* tierName(Tier tier);
+    static int scoreAdj(Tier tier);
+
+    // Tier of each renderer, given the apps on them
+    static QHash<uint32_t, Tier> rendererTiers(const std::vector<AppTier>& apps);
+    // Writes the scores of renderers whose tier has changed; renderers
+    // scored before and missing from |tiers| are scored as empty if alive
+    void apply(QHash<uint32_t, Tier> tiers);
+
+    // Re-scores on the next main loop turn; |createdPid| is scored anew
+    void schedule(uint32_t createdPid = 0);
+    // Accounts the tier |pid| was in; only the first report of a pid counts
+    void processCrashed(uint32_t pid);
+
+    QJsonObject stats() const;
+
+private:
+    void update();
+    bool isAlive(uint32_t pid) const;
+    bool writeScoreAdj(uint32_t pid, Tier tier);
+
+    QString m_procRoot;
+    QHash<uint32_t, Tier> m_tiers;
+    OneShotTimer<OomScoreManager> m_updateTimer;
+
+    unsigned m_updates;
+    unsigned m_writes;
+    unsigned m_failures;
+    unsigned m_crashes[TierCount];
+};
+
+#endif /* OOMSCOREMANAGER_H */
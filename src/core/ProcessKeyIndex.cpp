@@ -0,0 +1,99 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ProcessKeyIndex.h"
+
+#include <QStringList>
+
+ProcessKeyIndex::ProcessKeyIndex()
+{
+    clear();
+}
+
+void ProcessKeyIndex::clear()
+{
+    m_keys.clear();
+    m_appIds.clear();
+    m_trustLevels.clear();
+    m_prefixes.assign(1, Node());
+}
+
+void ProcessKeyIndex::addAppIds(const QString& entry)
+{
+    int key = static_cast<int>(m_keys.size());
+    m_keys.push_back(entry);
+
+    if (!entry.contains(QChar('*'))) {
+        for (const QString& id : entry.split(QChar(','))) {
+            if (!m_appIds.contains(id))
+                m_appIds.insert(id, key);
+        }
+        return;
+    }
+
+    QString prefixes(entry);
+    prefixes.remove(QChar('*'));
+    for (const QString& prefix : prefixes.split(QChar(','))) {
+        int node = 0;
+        for (QChar c : prefix) {
+            int child = m_prefixes[node].children.value(c, -1);
+            if (child < 0) {
+                child = static_cast<int>(m_prefixes.size());
+                m_prefixes[node].children.insert(c, child);
+                m_prefixes.push_back(Node());
+            }
+            node = child;
+        }
+        if (m_prefixes[node].key < 0)
+            m_prefixes[node].key = key;
+    }
+}
+
+void ProcessKeyIndex::addTrustLevels(const QString& entry)
+{
+    int key = static_cast<int>(m_keys.size());
+    m_keys.push_back(entry);
+
+    for (const QString& trustLevel : entry.split(QChar(','))) {
+        if (!m_trustLevels.contains(trustLevel))
+            m_trustLevels.insert(trustLevel, key);
+    }
+}
+
+QString ProcessKeyIndex::find(const QString& appId, const QString& trustLevel) const
+{
+    int key = m_appIds.value(appId, -1);
+    if (key < 0)
+        key = findPrefix(appId);
+    if (key < 0)
+        key = m_trustLevels.value(trustLevel, -1);
+
+    return key < 0 ? QString() : m_keys[key];
+}
+
+int ProcessKeyIndex::findPrefix(const QString& appId) const
+{
+    int node = 0;
+    int key = m_prefixes[node].key;
+    for (QChar c : appId) {
+        node = m_prefixes[node].children.value(c, -1);
+        if (node < 0)
+            break;
+        if (m_prefixes[node].key >= 0)
+            key = m_prefixes[node].key;
+    }
+    return key;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PROCESSKEYINDEX_H
+#define PROCESSKEYINDEX_H
+
+#include <vector>
+
+#include <QHash>
+#include <QString>
+
+/**
+ * The webProcessList policy of the web process configuration, compiled
+ * for lookups by app id and trust level.
+ *
+ * Every "id" entry is a comma separated list of app ids; if it contains a
+ * '*' each of them is a prefix instead. Exact ids go to a hash table,
+ * prefixes to a trie. Lookups prefer an exact id, then the longest
+ * prefix, then the trust level; among equal matches the first entry wins.
+ */
+class ProcessKeyIndex {
+public:
+    ProcessKeyIndex();
+
+    void clear();
+    void addAppIds(const QString& entry);
+    void addTrustLevels(const QString& entry);
+
+    // Key (the policy entry) of the group of |appId|, empty if none matches
+    QString find(const QString& appId, const QString& trustLevel) const;
+
+private:
+    struct Node {
+        Node() : key(-1) {}
+
+        QHash<QChar, int> children;
+        int key;
+    };
+
+    int findPrefix(const QString& appId) const;
+
+    std::vector<QString> m_keys;
+    QHash<QString, int> m_appIds;
+    QHash<QString, int> m_trustLevels;
+    std::vector<Node> m_prefixes;
+};
+
+#endif /* PROCESSKEYINDEX_H */
@@ -0,0 +1,206 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ProcessSampler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include <glib.h>
+
+const size_t ProcessSampler::kHistorySize;
+const unsigned ProcessSampler::kRollupRounds;
+
+const ProcessSample* ProcessSnapshot::latest(uint32_t pid) const
+{
+    const History* samples = history(pid);
+    return samples && !samples->empty() ? &samples->back() : nullptr;
+}
+
+const ProcessSnapshot::History* ProcessSnapshot::history(uint32_t pid) const
+{
+    auto it = m_processes.find(pid);
+    return it != m_processes.end() ? &it->second : nullptr;
+}
+
+ProcessSampler::ProcessSampler(int intervalMs)
+    : m_intervalMs(intervalMs)
+    , m_stopped(false)
+    , m_round(0)
+    , m_snapshot(std::make_shared<ProcessSnapshot>())
+{
+    m_pids.insert(getpid());
+    m_thread = std::thread(&ProcessSampler::run, this);
+}
+
+ProcessSampler::~ProcessSampler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+}
+
+void ProcessSampler::watch(uint32_t pid)
+{
+    if (!pid)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pids.insert(pid);
+}
+
+std::shared_ptr<const ProcessSnapshot> ProcessSampler::snapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+void ProcessSampler::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopped) {
+        std::set<uint32_t> pids(m_pids);
+        lock.unlock();
+
+        sample(pids);
+
+        lock.lock();
+        // Forget processes that are gone
+        for (uint32_t pid : pids) {
+            if (!m_histories.count(pid))
+                m_pids.erase(pid);
+        }
+        m_pids.insert(getpid());
+
+        m_wakeup.wait_for(lock, std::chrono::milliseconds(m_intervalMs), [this] { return m_stopped; });
+    }
+}
+
+void ProcessSampler::sample(const std::set<uint32_t>& pids)
+{
+    bool rollup = m_round++ % kRollupRounds == 0;
+    for (uint32_t pid : pids) {
+        ProcessSnapshot::History& history = m_histories[pid];
+        const ProcessSample* previous = nullptr;
+        if (!history.empty()) {
+            size_t next = m_next.count(pid) ? m_next[pid] : 0;
+            previous = history.size() < kHistorySize ? &history.back()
+                                                     : &history[(next + kHistorySize - 1) % kHistorySize];
+        }
+
+        ProcessSample sample;
+        // A new process is read in full right away
+        if (!read(pid, sample, previous, rollup || !previous)) {
+            m_histories.erase(pid);
+            m_next.erase(pid);
+            continue;
+        }
+
+        if (history.size() < kHistorySize) {
+            history.push_back(sample);
+        } else {
+            size_t& next = m_next[pid];
+            history[next] = sample;
+            next = (next + 1) % kHistorySize;
+        }
+    }
+
+    std::shared_ptr<ProcessSnapshot> snapshot = std::make_shared<ProcessSnapshot>();
+    for (const auto& it : m_histories) {
+        // Store oldest first
+        ProcessSnapshot::History& history = snapshot->m_processes[it.first];
+        size_t next = m_next.count(it.first) ? m_next[it.first] : 0;
+        history.reserve(it.second.size());
+        history.insert(history.end(), it.second.begin() + next, it.second.end());
+        history.insert(history.end(), it.second.begin(), it.second.begin() + next);
+    }
+
+    std::shared_ptr<const ProcessSnapshot> published(snapshot);
+    std::atomic_store(&m_snapshot, published);
+}
+
+static uint64_t readKB(const char* line, size_t prefixLength)
+{
+    return strtoull(line + prefixLength, nullptr, 10);
+}
+
+bool ProcessSampler::read(uint32_t pid, ProcessSample& sample, const ProcessSample* previous, bool rollup)
+{
+    char path[64];
+    char line[256];
+
+    snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+    FILE* fp = fopen(path, "r");
+    if (!fp)
+        return false;
+
+    if (fgets(line, sizeof(line), fp)) {
+        // utime and stime are the 12th and 13th fields after "(comm)"
+        const char* p = strrchr(line, ')');
+        for (int field = 0; p && field < 12; ++field)
+            p = strchr(p + 1, ' ');
+        if (p) {
+            char* end = nullptr;
+            uint64_t utime = strtoull(p, &end, 10);
+            uint64_t stime = strtoull(end, nullptr, 10);
+            static const long ticks = sysconf(_SC_CLK_TCK);
+            if (ticks > 0)
+                sample.cpuTime = (utime + stime) * 1000 / ticks;
+        }
+    }
+    fclose(fp);
+
+    snprintf(path, sizeof(path), "/proc/%u/status", pid);
+    if ((fp = fopen(path, "r"))) {
+        while (fgets(line, sizeof(line), fp)) {
+            if (!strncmp(line, "VmRSS:", 6))
+                sample.rss = readKB(line, 6);
+            else if (!strncmp(line, "VmSwap:", 7))
+                sample.swap = readKB(line, 7);
+        }
+        fclose(fp);
+    }
+
+    sample.timestamp = g_get_monotonic_time();
+    if (!rollup) {
+        sample.pss = previous->pss;
+        sample.uss = previous->uss;
+        sample.rollupTimestamp = previous->rollupTimestamp;
+        return true;
+    }
+
+    // Not there before linux 4.14; rss and swap of status are kept then
+    snprintf(path, sizeof(path), "/proc/%u/smaps_rollup", pid);
+    sample.rollupTimestamp = sample.timestamp;
+    if ((fp = fopen(path, "r"))) {
+        while (fgets(line, sizeof(line), fp)) {
+            if (!strncmp(line, "Pss:", 4))
+                sample.pss = readKB(line, 4);
+            else if (!strncmp(line, "Private_Clean:", 14) || !strncmp(line, "Private_Dirty:", 14))
+                sample.uss += readKB(line, 14);
+            else if (!strncmp(line, "Swap:", 5))
+                sample.swap = readKB(line, 5);
+        }
+        fclose(fp);
+    }
+    return true;
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PROCESSSAMPLER_H
+#define PROCESSSAMPLER_H
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Memory and cpu usage of a process at one point in time.
+ * Sizes are in kB, cpuTime (user + system) in ms.
+ */
+struct ProcessSample {
+    ProcessSample()
+        : timestamp(0), rollupTimestamp(0), rss(0), pss(0), uss(0), swap(0), cpuTime(0)
+    {
+    }
+
+    int64_t timestamp; // g_get_monotonic_time()
+    int64_t rollupTimestamp; // when pss and uss were read
+    uint64_t rss;
+    uint64_t pss;
+    uint64_t uss;
+    uint64_t swap;
+    uint64_t cpuTime;
+};
+
+/**
+ * Samples taken of every watched process, oldest first.
+ * Published as a whole and never changed afterwards.
+ */
+class ProcessSnapshot {
+public:
+    typedef std::vector<ProcessSample> History;
+
+    // Latest sample of |pid|, nullptr if it is not sampled
+    const ProcessSample* latest(uint32_t pid) const;
+    const History* history(uint32_t pid) const;
+
+private:
+    friend class ProcessSampler;
+
+    std::unordered_map<uint32_t, History> m_processes;
+};
+
+/**
+ * Reads smaps_rollup, stat and status of the watched processes (and of
+ * WAM itself) on a thread of its own, every |intervalMs|.
+ *
+ * The last kHistorySize samples of each process are published as an
+ * immutable ProcessSnapshot by swapping a shared pointer, so readers on
+ * the main loop never wait for procfs. Processes that are gone are
+ * dropped on the next round.
+ */
+class ProcessSampler {
+public:
+    static const size_t kHistorySize = 16;
+    // smaps_rollup walks every mapping under the process' mmap lock, so
+    // pss and uss are read every kRollupRounds rounds only
+    static const unsigned kRollupRounds = 5;
+
+    explicit ProcessSampler(int intervalMs);
+    ~ProcessSampler();
+
+    void watch(uint32_t pid);
+    std::shared_ptr<const ProcessSnapshot> snapshot() const;
+
+private:
+    void run();
+    void sample(const std::set<uint32_t>& pids);
+    static bool read(uint32_t pid, ProcessSample& sample, const ProcessSample* previous, bool rollup);
+
+    int m_intervalMs;
+    std::thread m_thread;
+
+    // Guards m_pids and m_stopped
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::set<uint32_t> m_pids;
+    bool m_stopped;
+
+    // Owned by the sampling thread
+    std::unordered_map<uint32_t, ProcessSnapshot::History> m_histories;
+    std::unordered_map<uint32_t, size_t> m_next;
+    unsigned m_round;
+
+    std::shared_ptr<const ProcessSnapshot> m_snapshot;
+};
+
+#endif /* PROCESSSAMPLER_H */
@@ -0,0 +1,233 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "RendererPriorityManager.h"
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <QDir>
+#include <QSet>
+
+#include "LogManager.h"
+#include "WebAppBase.h"
+#include "WebAppManager.h"
+#include "WebAppManagerUtils.h"
+#include "WebAppRegistry.h"
+#include "WebPageBase.h"
+#include "WebProcessManager.h"
+
+// From linux/ioprio.h, which glibc does not wrap
+static const int kIoprioWhoProcess = 1;
+static const int kIoprioClassBestEffort = 2;
+static const int kIoprioClassShift = 13;
+
+struct TierPriority {
+    int cpuWeight; // cgroup v2: 1..10000, 100 by default
+    int ioWeight;
+    int nice;
+    int ioprioLevel; // best effort: 0 (highest) .. 7
+};
+
+static const TierPriority kTierPriorities[RendererPriorityManager::TierCount] = {
+    { 1000, 1000, 0, 0 }, // foreground
+    { 100, 100, 0, 4 }, // shared
+    { 20, 25, 10, 7 }, // background
+};
+
+static bool writeFile(const QString& path, const QByteArray& value, bool append = false)
+{
+    return WebAppManagerUtils::writeFile(path.toStdString(), value.toStdString(), append);
+}
+
+RendererPriorityManager::RendererPriorityManager(const QString& cgroupRoot, const QString& backgroundCpuMax)
+    : m_cgroupRoot(cgroupRoot)
+    , m_backgroundCpuMax(backgroundCpuMax)
+    , m_useCgroups(false)
+    , m_rebalances(0)
+    , m_moves(0)
+    , m_failures(0)
+{
+    m_useCgroups = setUpCgroups();
+    LOG_INFO(MSGID_RENDERER_PRIORITY, 2, PMLOGKS("MODE", m_useCgroups ? "cgroup" : "nice"), PMLOGKS("ROOT", qPrintable(m_cgroupRoot)), "");
+}
+
+const char* RendererPriorityManager::tierName(Tier tier)
+{
+    switch (tier) {
+        case TierForeground: return "foreground";
+        case TierShared: return "shared";
+        case TierBackground: return "background";
+        default: return "none";
+    }
+}
+
+bool RendererPriorityManager::setUpCgroups()
+{
+    if (m_cgroupRoot.isEmpty() || !QDir().mkpath(m_cgroupRoot))
+        return false;
+
+    // Children only get the controllers their parent hands down; this
+    // fails harmlessly where they are delegated already
+    writeFile(m_cgroupRoot + QStringLiteral("/cgroup.subtree_control"), "+cpu +io");
+
+    for (int i = 0; i < TierCount; i++) {
+        QString group = m_cgroupRoot + QLatin1Char('/') + QLatin1String(tierName(static_cast<Tier>(i)));
+        if (!QDir().mkpath(group))
+            return false;
+
+        const TierPriority& priority = kTierPriorities[i];
+        if (!writeFile(group + QStringLiteral("/cpu.weight"), QByteArray::number(priority.cpuWeight)))
+            return false;
+        writeFile(group + QStringLiteral("/io.weight"), "default " + QByteArray::number(priority.ioWeight));
+    }
+
+    if (!m_backgroundCpuMax.isEmpty())
+        writeFile(m_cgroupRoot + QStringLiteral("/background/cpu.max"), m_backgroundCpuMax.toUtf8());
+    return true;
+}
+
+void RendererPriorityManager::schedule(uint32_t createdPid)
+{
+    if (createdPid)
+        m_tiers.remove(createdPid);
+
+    if (!m_rebalanceTimer.isRunning())
+        m_rebalanceTimer.start(0, this, &RendererPriorityManager::rebalance);
+}
+
+void RendererPriorityManager::rebalance()
+{
+    WebAppManager* manager = WebAppManager::instance();
+    WebProcessManager* processes = manager->getWebProcessManager();
+    if (!processes)
+        return;
+
+    std::vector<AppState> apps;
+    for (const WebAppBase* app : manager->appRegistry()) {
+        if (!app->page() || app->isClosing())
+            continue;
+
+        uint32_t pid = processes->getWebProcessPID(app);
+        if (!pid)
+            continue;
+
+        apps.push_back(AppState{pid, processes->getProcessKey(app->getAppDescription()),
+                                app->isActivated() && !app->page()->isPreload()});
+    }
+
+    apply(rendererTiers(apps));
+}
+
+QHash<uint32_t, RendererPriorityManager::Tier> RendererPriorityManager::rendererTiers(const std::vector<AppState>& apps)
+{
+    QHash<uint32_t, Tier> tiers;
+    QHash<uint32_t, QString> keys;
+    QSet<QString> foregroundKeys;
+    for (const AppState& app : apps) {
+        keys.insert(app.pid, app.key);
+        if (app.shown) {
+            tiers.insert(app.pid, TierForeground);
+            foregroundKeys.insert(app.key);
+        } else if (!tiers.contains(app.pid)) {
+            tiers.insert(app.pid, TierBackground);
+        }
+    }
+
+    // Every app shares the "system" key, only real groups are shared
+    for (auto it = tiers.begin(); it != tiers.end(); ++it) {
+        const QString& key = keys.value(it.key());
+        if (it.value() == TierBackground && key != QStringLiteral("system") && foregroundKeys.contains(key))
+            it.value() = TierShared;
+    }
+    return tiers;
+}
+
+void RendererPriorityManager::apply(const QHash<uint32_t, Tier>& tiers)
+{
+    // Renderers that are gone drop out, and those that failed to move are
+    // left out so that the next rebalance tries them again
+    QHash<uint32_t, Tier> placed;
+    for (auto it = tiers.constBegin(); it != tiers.constEnd(); ++it) {
+        uint32_t pid = it.key();
+        Tier tier = it.value();
+        if (m_tiers.value(pid, TierCount) == tier) {
+            placed.insert(pid, tier);
+            continue;
+        }
+
+        bool moved = (m_useCgroups && moveToCgroup(pid, tier)) || setSchedulingPriority(pid, tier);
+        if (moved) {
+            placed.insert(pid, tier);
+            m_moves++;
+        } else {
+            m_failures++;
+        }
+        LOG_DEBUG("Web process %u %s to %s", pid, moved ? "moved" : "failed to move", tierName(tier));
+    }
+
+    m_tiers = placed;
+    m_rebalances++;
+}
+
+bool RendererPriorityManager::moveToCgroup(uint32_t pid, Tier tier)
+{
+    QString procs = m_cgroupRoot + QLatin1Char('/') + QLatin1String(tierName(tier)) + QStringLiteral("/cgroup.procs");
+    return writeFile(procs, QByteArray::number(pid), true);
+}
+
+bool RendererPriorityManager::setSchedulingPriority(uint32_t pid, Tier tier)
+{
+    const TierPriority& priority = kTierPriorities[tier];
+    int ioprio = (kIoprioClassBestEffort << kIoprioClassShift) | priority.ioprioLevel;
+
+    // Both are per thread on Linux
+    QStringList threads = QDir(QStringLiteral("/proc/%1/task").arg(pid)).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    if (threads.isEmpty())
+        return false;
+
+    bool done = true;
+    for (const QString& thread : threads) {
+        int tid = thread.toInt();
+        if (setpriority(PRIO_PROCESS, tid, priority.nice) == -1)
+            done = false;
+        if (syscall(SYS_ioprio_set, kIoprioWhoProcess, tid, ioprio) == -1)
+            done = false;
+    }
+    return done;
+}
+
+QJsonObject RendererPriorityManager::stats() const
+{
+    int counts[TierCount] = {};
+    for (Tier tier : m_tiers)
+        counts[tier]++;
+
+    QJsonObject tiers;
+    for (int i = 0; i < TierCount; i++)
+        tiers[tierName(static_cast<Tier>(i))] = counts[i];
+
+    QJsonObject stats;
+    stats["mode"] = m_useCgroups ? "cgroup" : "nice";
+    stats["cgroupRoot"] = m_cgroupRoot;
+    stats["rebalances"] = static_cast<int>(m_rebalances);
+    stats["moves"] = static_cast<int>(m_moves);
+    stats["failures"] = static_cast<int>(m_failures);
+    stats["renderers"] = tiers;
+    return stats;
+}
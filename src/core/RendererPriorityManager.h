@@ -0,0 +1,95 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef RENDERERPRIORITYMANAGER_H
+#define RENDERERPRIORITYMANAGER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+#include "Timer.h"
+
+/**
+ * Gives the renderer of the foreground app CPU and I/O ahead of the rest.
+ *
+ * Renderers fall into three tiers:
+ *  - foreground: hosts an app that is shown,
+ *  - shared: hosts none, but its process key (other than "system") has a
+ *    renderer that does; left at default weight as the shown app may
+ *    depend on it,
+ *  - background: hosts only hidden or preloaded apps.
+ *
+ * With cgroup v2, each tier is a child group of |cgroupRoot| weighted by
+ * cpu.weight and io.weight, the background one also capped by cpu.max.
+ * Where those groups can't be set up, nice and ioprio of the renderer's
+ * threads are used instead. Getting back from a higher nice value takes
+ * CAP_SYS_NICE, so without it that fallback can only lower priorities.
+ */
+class RendererPriorityManager {
+public:
+    enum Tier {
+        TierForeground = 0,
+        TierShared,
+        TierBackground,
+        TierCount
+    };
+
+    struct AppState {
+        uint32_t pid; // of its renderer
+        QString key; // process key
+        bool shown; // in the foreground, and not as a preload
+    };
+
+    // |backgroundCpuMax| is written as is to cpu.max, e.g. "20000 100000"
+    RendererPriorityManager(const QString& cgroupRoot, const QString& backgroundCpuMax);
+
+    static const char* tierName(Tier tier);
+
+    // Tier of each renderer, given the apps on them
+    static QHash<uint32_t, Tier> rendererTiers(const std::vector<AppState>& apps);
+    // Moves renderers whose tier has changed, or whose last move failed;
+    // those missing from |tiers| drop out
+    void apply(const QHash<uint32_t, Tier>& tiers);
+
+    // Re-balances on the next main loop turn, as focus changes come in bursts;
+    // |createdPid| is a renderer that has just come up and is placed anew
+    void schedule(uint32_t createdPid = 0);
+
+    QJsonObject stats() const;
+
+private:
+    void rebalance();
+    bool setUpCgroups();
+    bool moveToCgroup(uint32_t pid, Tier tier);
+    bool setSchedulingPriority(uint32_t pid, Tier tier);
+
+    QString m_cgroupRoot;
+    QString m_backgroundCpuMax;
+    bool m_useCgroups;
+    QHash<uint32_t, Tier> m_tiers;
+    OneShotTimer<RendererPriorityManager> m_rebalanceTimer;
+
+    unsigned m_rebalances;
+    unsigned m_moves;
+    unsigned m_failures;
+};
+
+#endif /* RENDERERPRIORITYMANAGER_H */
@@ -0,0 +1,121 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "SuspendDelayLearner.h"
+
+#include "LaunchTimeline.h"
+
+// Upper bounds of the buckets in ms; the last bucket takes the rest
+static const int kBucketBounds[SuspendDelayLearner::kBucketCount - 1] = {
+    250, 500, 750, 1000, 1500, 2000, 3000, 5000, 10000
+};
+
+// Weight kept by past intervals each time a new one comes in
+static const double kDecay = 0.9;
+// Weight of history needed before an app's delay is learned
+static const double kMinWeight = 3.0;
+// Share of hides a longer delay has to spare a cycle for
+static const double kMinAvoidedShare = 0.25;
+
+static int bucketOf(int64_t intervalMs)
+{
+    for (int i = 0; i < SuspendDelayLearner::kBucketCount - 1; i++) {
+        if (intervalMs <= kBucketBounds[i])
+            return i;
+    }
+    return SuspendDelayLearner::kBucketCount - 1;
+}
+
+SuspendDelayLearner::SuspendDelayLearner()
+    : m_hides(0)
+    , m_cycles(0)
+    , m_avoidedCycles(0)
+    , m_extendedCycles(0)
+{
+}
+
+int SuspendDelayLearner::delay(const QString& appId, int baseMs, int maxMs) const
+{
+    if (maxMs <= baseMs)
+        return baseMs;
+
+    auto it = m_histories.constFind(appId);
+    if (it == m_histories.constEnd() || it.value().total < kMinWeight)
+        return baseMs;
+
+    // Only intervals the base delay would have suspended for count
+    const History& history = it.value();
+    double avoided = 0;
+    for (int i = 0; i < kBucketCount - 1 && kBucketBounds[i] <= maxMs; i++) {
+        int lower = i ? kBucketBounds[i - 1] : 0;
+        if (lower < baseMs)
+            continue;
+        avoided += history.weights[i];
+        if (avoided / history.total >= kMinAvoidedShare)
+            return kBucketBounds[i];
+    }
+    return baseMs;
+}
+
+void SuspendDelayLearner::hidden(const QString& appId, int baseMs, int delayMs)
+{
+    auto it = m_histories.find(appId);
+    if (it == m_histories.end())
+        it = m_histories.insert(appId, History{{}, 0, 0, 0, 0});
+
+    History& history = it.value();
+    history.hiddenAt = LaunchTimeline::now();
+    history.baseMs = baseMs;
+    history.delayMs = delayMs;
+    m_hides++;
+}
+
+void SuspendDelayLearner::shown(const QString& appId, bool suspended)
+{
+    auto it = m_histories.find(appId);
+    if (it == m_histories.end() || !it.value().hiddenAt)
+        return;
+
+    History& history = it.value();
+    int64_t intervalMs = (LaunchTimeline::now() - history.hiddenAt) / 1000;
+    history.hiddenAt = 0;
+
+    for (int i = 0; i < kBucketCount; i++)
+        history.weights[i] *= kDecay;
+    history.weights[bucketOf(intervalMs)] += 1;
+    history.total = history.total * kDecay + 1;
+
+    if (suspended) {
+        m_cycles++;
+        if (history.delayMs > history.baseMs)
+            m_extendedCycles++;
+    } else if (intervalMs >= history.baseMs) {
+        // The base delay would have suspended and resumed it for nothing
+        m_avoidedCycles++;
+    }
+}
+
+QJsonObject SuspendDelayLearner::stats() const
+{
+    QJsonObject stats;
+    stats["apps"] = m_histories.size();
+    stats["hides"] = static_cast<int>(m_hides);
+    stats["cycles"] = static_cast<int>(m_cycles);
+    stats["avoidedCycles"] = static_cast<int>(m_avoidedCycles);
+    stats["extendedButSuspended"] = static_cast<int>(m_extendedCycles);
+    return stats;
+}
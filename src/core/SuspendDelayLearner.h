@@ -0,0 +1,70 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef SUSPENDDELAYLEARNER_H
+#define SUSPENDDELAYLEARNER_H
+
+#include <stdint.h>
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * Learns how soon each app tends to be shown again after being hidden,
+ * to hold off suspending the DOM of apps the user flips back to.
+ *
+ * Hide-to-show intervals go into a histogram per app whose weights decay
+ * with each new interval, so recent habits count most. Once an app has
+ * enough history, its delay is the shortest bucket bound above the base
+ * delay, and within the maximum, that would have kept a fair share of
+ * its hides from paying a suspend/resume cycle.
+ */
+class SuspendDelayLearner {
+public:
+    static const int kBucketCount = 10;
+
+    SuspendDelayLearner();
+
+    // Delay to suspend |appId| with, between |baseMs| and |maxMs|
+    int delay(const QString& appId, int baseMs, int maxMs) const;
+
+    // |appId| was hidden, its DOM to be suspended after |delayMs|
+    void hidden(const QString& appId, int baseMs, int delayMs);
+    // |appId| is shown again; |suspended| if its DOM was suspended meanwhile
+    void shown(const QString& appId, bool suspended);
+
+    QJsonObject stats() const;
+
+private:
+    struct History {
+        double weights[kBucketCount];
+        double total;
+        int64_t hiddenAt; // 0 if not hidden
+        int baseMs;
+        int delayMs;
+    };
+
+    QHash<QString, History> m_histories;
+
+    unsigned m_hides;
+    unsigned m_cycles;
+    unsigned m_avoidedCycles;
+    unsigned m_extendedCycles;
+};
+
+#endif /* SUSPENDDELAYLEARNER_H */
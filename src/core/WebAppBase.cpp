@@ -16,9 +16,6 @@
 
 #include "WebAppBase.h"
 
-#include <QtCore/QJsonDocument>
-#include <QtCore/QJsonObject>
-
 #include "ApplicationDescription.h"
 #include "LogManager.h"
 #include "WebAppManagerConfig.h"
@@ -68,6 +65,10 @@ WebAppBase::WebAppBase()
     , m_crashed(false)
     , m_hiddenWindow(false)
     , m_closePageRequested(false)
+    , m_lastForegroundTime(LaunchTimeline::now())
+    , m_launchTime(m_lastForegroundTime)
+    , m_restoreStart(0)
+    , m_preloadMemoryRecorded(false)
 {
 }
 
@@ -185,9 +186,16 @@ int WebAppBase::currentUiHeight()
 
 void WebAppBase::setActiveAppId(QString id)
 {
+    updateLastForegroundTime();
+    WebAppManager::instance()->appForegrounded(this);
     WebAppManager::instance()->setActiveAppId(id);
 }
 
+void WebAppBase::updateLastForegroundTime()
+{
+    m_lastForegroundTime = LaunchTimeline::now();
+}
+
 void WebAppBase::forceCloseAppInternal()
 {
     WebAppManager::instance()->forceCloseAppInternal(this);
@@ -198,6 +206,24 @@ void WebAppBase::closeAppInternal()
     WebAppManager::instance()->closeAppInternal(this);
 }
 
+bool WebAppBase::discardPage()
+{
+    if (!d->m_page || !d->m_page->discard())
+        return false;
+
+    WebAppManager::instance()->pageRecreated(this);
+    return true;
+}
+
+void WebAppBase::finishRestore()
+{
+    if (!m_restoreStart)
+        return;
+
+    WebAppManager::instance()->appRestored(this, LaunchTimeline::now() - m_restoreStart);
+    m_restoreStart = 0;
+}
+
 void WebAppBase::attach(WebPageBase* page)
 {
     // connect to the signals of the WebBridge
@@ -225,7 +251,7 @@ WebPageBase* WebAppBase::detach(void)
     return p;
 }
 
-void WebAppBase::relaunch(const QString& args, const QString& launchingAppId)
+void WebAppBase::relaunch(const LaunchParams& args, const QString& launchingAppId)
 {
     LOG_INFO(MSGID_APP_RELAUNCH, 3,
              PMLOGKS("APP_ID", qPrintable(appId())),
@@ -291,14 +317,14 @@ void WebAppBase::webPageLoadFinishedSlot()
 
 void WebAppBase::doPendingRelaunch()
 {
-    if(m_inProgressRelaunchLaunchingAppId.size() || m_inProgressRelaunchParams.size()) {
+    if(m_inProgressRelaunchLaunchingAppId.size() || !m_inProgressRelaunchParams.isNull()) {
       LOG_INFO(MSGID_APP_RELAUNCH, 2,
                PMLOGKS("APP_ID", qPrintable(appId())),
                PMLOGKFV("PID", "%d", page()->getWebProcessPID()),
                "Page loading --> done; Do pending Relaunch");
         relaunch(m_inProgressRelaunchParams, m_inProgressRelaunchLaunchingAppId);
 
-        m_inProgressRelaunchParams.clear();
+        m_inProgressRelaunchParams = LaunchParams();
         m_inProgressRelaunchLaunchingAppId.clear();
     }
 }
@@ -343,26 +369,20 @@ void WebAppBase::setAppDescription(std::shared_ptr<ApplicationDescription> appDe
    d->m_appId = QString::fromStdString(appDesc->id());
 }
 
-void WebAppBase::setAppProperties(QString properties)
+void WebAppBase::setAppProperties(const LaunchParams& properties)
 {
-    QJsonDocument doc = QJsonDocument::fromJson(properties.toStdString().c_str());
-    QJsonObject obj = doc.object();
-
-    if (obj["keepAlive"].toBool())
+    if (properties.keepAlive())
         setKeepAlive(true);
     else
         setKeepAlive(false);
 
-    if (obj["launchedHidden"].toBool())
+    if (properties.launchedHidden())
         setHiddenWindow(true);
 }
 
-void WebAppBase::setPreloadState(QString properties)
+void WebAppBase::setPreloadState(const LaunchParams& properties)
 {
-    QJsonDocument doc = QJsonDocument::fromJson(properties.toStdString().c_str());
-    QJsonObject obj = doc.object();
-
-    std::string preload = obj["preload"].toString().toStdString().c_str();
+    std::string preload = properties.preload().toStdString();
 
     if (preload == "full") {
         m_preloadState = FULL_PRELOAD;
@@ -376,12 +396,14 @@ void WebAppBase::setPreloadState(QString properties)
     else if (preload == "minimal") {
         m_preloadState = MINIMAL_PRELOAD;
     }
-    else if (obj["launchedHidden"].toBool()) {
+    else if (properties.launchedHidden()) {
         m_preloadState = PARTIAL_PRELOAD;
     }
 
-    if (m_preloadState != NONE_PRELOAD)
+    if (m_preloadState != NONE_PRELOAD) {
         setHiddenWindow(true);
+        m_preloadMemoryRecorded = false;
+    }
 
     // set PreloadEnvironment needs attaching WebPageBase.
     if (!d->m_page)
@@ -389,7 +411,8 @@ void WebAppBase::setPreloadState(QString properties)
 
     switch (m_preloadState) {
         case FULL_PRELOAD :
-            // TODO : implement full preload when rule is set.
+            // Load and run as if shown, only keep media quiet while hidden
+            d->m_page->suspendWebPageMedia();
             break;
         case SEMI_FULL_PRELOAD:
             d->m_page->setAppPreloadHint(true);
@@ -401,7 +424,7 @@ void WebAppBase::setPreloadState(QString properties)
             d->m_page->deactivateRendererCompositor();
             break;
         case MINIMAL_PRELOAD :
-            // TODO : implement minimal preloaded when rule is set.
+            // Nothing to hold back yet; the page is not loaded until relaunch
             break;
         default :
             break;
@@ -409,6 +432,17 @@ void WebAppBase::setPreloadState(QString properties)
     d->m_page->setIsPreload(m_preloadState != NONE_PRELOAD ? true : false);
 }
 
+const char* WebAppBase::preloadStateName(PreloadState state)
+{
+    switch (state) {
+        case FULL_PRELOAD: return "full";
+        case SEMI_FULL_PRELOAD: return "semi-full";
+        case PARTIAL_PRELOAD: return "partial";
+        case MINIMAL_PRELOAD: return "minimal";
+        default: return "none";
+    }
+}
+
 void WebAppBase::clearPreloadState()
 {
    // set PreloadEnvironment needs attaching WebPageBase.
@@ -419,7 +453,7 @@ void WebAppBase::clearPreloadState()
 
     switch (m_preloadState) {
         case FULL_PRELOAD :
-            // TODO : implement full preload when rule is set.
+            d->m_page->resumeWebPageMedia();
             break;
         case SEMI_FULL_PRELOAD:
             d->m_page->setAppPreloadHint(false);
@@ -431,7 +465,8 @@ void WebAppBase::clearPreloadState()
             d->m_page->activateRendererCompositor();
             break;
         case MINIMAL_PRELOAD :
-            // TODO : implement minimal preloaded when rule is set.
+            // WebAppManager::onLaunchUrl deferred the load until now
+            d->m_page->load();
             break;
         default :
             break;
@@ -508,7 +543,7 @@ void WebAppBase::dispatchUnload()
 
 void WebAppBase::onCursorVisibilityChanged(const QString& jsscript)
 {
-    WebAppManager::instance()->sendEventToAllAppsAndAllFrames(jsscript);
+    WebAppManager::instance()->sendEventToAllAppsAndAllFrames(QStringLiteral("cursorStateChange"), jsscript);
 }
 
 void WebAppBase::serviceCall(const QString& url, const QString& payload, const QString& appId)
@@ -530,3 +565,17 @@ bool WebAppBase::isCheckLaunchTimeEnabled()
 {
     return WebAppManager::instance()->config()->isCheckLaunchTimeEnabled();
 }
+
+void WebAppBase::finishLaunchTimeline()
+{
+    if (!m_launchTimeline.isStarted())
+        return;
+
+    WebAppManager::instance()->recordLaunchTimeline(appId(), m_launchTimeline);
+    m_launchTimeline = LaunchTimeline();
+}
+
+void WebAppBase::navigationStarted()
+{
+    m_launchTimeline.mark(LaunchTimeline::NavigationStarted);
+}
@@ -22,6 +22,8 @@
 #include <QObject>
 #include <QString>
 
+#include "LaunchParams.h"
+#include "LaunchTimeline.h"
 #include "WebAppManager.h"
 #include "WebPageObserver.h"
 
@@ -62,7 +64,7 @@ public:
     virtual void configureWindow(QString& type) = 0;
     virtual void setKeepAlive(bool keepAlive);
     virtual bool isWindowed() const;
-    virtual void relaunch(const QString& args, const QString& launchingAppId);
+    virtual void relaunch(const LaunchParams& args, const QString& launchingAppId);
     virtual void setWindowProperty(const QString& name, const QVariant& value) = 0;
     virtual void platformBack() = 0;
     virtual void setCursor(const QString& cursorArg, int hotspot_x, int hotspot_y) = 0;
@@ -86,6 +88,7 @@ public:
     virtual bool isKeyboardVisible() { return false; }
     static void onCursorVisibilityChanged(const QString& jsscript);
     virtual bool hideWindow() = 0;
+    virtual bool discardPage();
 
     bool getCrashState();
     void setCrashState(bool state);
@@ -105,7 +108,7 @@ public:
 
     ApplicationDescription* getAppDescription() const;
 
-    void setAppProperties(QString properties);
+    void setAppProperties(const LaunchParams& properties);
 
     void setNeedReload(bool status) { m_needReload = status; }
     bool needReload() { return m_needReload; }
@@ -120,23 +123,45 @@ public:
     void setUseAccessibility(bool enabled);
     void serviceCall(const QString& url, const QString& payload, const QString& appId);
 
-    void setPreloadState(QString properties);
+    void setPreloadState(const LaunchParams& properties);
     void clearPreloadState();
     PreloadState preloadState() { return m_preloadState; }
+    static const char* preloadStateName(PreloadState state);
+    // Memory of the current preload was accounted for
+    bool preloadMemoryRecorded() const { return m_preloadMemoryRecorded; }
+    void setPreloadMemoryRecorded(bool recorded) { m_preloadMemoryRecorded = recorded; }
 
     bool isClosing() const;
     bool isCheckLaunchTimeEnabled();
     void setClosePageRequested(bool requested) { m_closePageRequested = requested; }
     bool closePageRequested() { return m_closePageRequested; }
 
+    // Launch phases are recorded until the last frame of the launch is swapped
+    void startLaunchTimeline(const LaunchTimeline& timeline) { m_launchTimeline = timeline; }
+    void markLaunchPhase(LaunchTimeline::Phase phase) { m_launchTimeline.mark(phase); }
+    bool isLaunchTimelineRunning() const { return m_launchTimeline.isStarted(); }
+    void finishLaunchTimeline();
+
+    // Last time (LaunchTimeline::now()) the app was in the foreground
+    int64_t lastForegroundTime() const { return m_lastForegroundTime; }
+    // Time (LaunchTimeline::now()) the app was created for its launch
+    int64_t launchTime() const { return m_launchTime; }
+    // Brought back from a background tier; timed until its next frame
+    void startRestore() { m_restoreStart = LaunchTimeline::now(); }
+
+    // WebPageObserver
+    void navigationStarted() override;
+
 protected:
     virtual void doAttach() = 0;
     virtual void showWindow();
 
     void setUiSize(int width, int height);
     void setActiveAppId(QString id);
+    void updateLastForegroundTime();
     void forceCloseAppInternal();
     void closeAppInternal();
+    void finishRestore();
 
 protected Q_SLOTS:
     virtual void webPageUrlChangedSlot();
@@ -149,7 +174,7 @@ protected Q_SLOTS:
 protected:
     PreloadState m_preloadState;
     bool m_addedToWindowMgr;
-    QString m_inProgressRelaunchParams;
+    LaunchParams m_inProgressRelaunchParams;
     QString m_inProgressRelaunchLaunchingAppId;
     float m_scaleFactor;
 
@@ -159,5 +184,10 @@ private:
     bool m_crashed;
     bool m_hiddenWindow;
     bool m_closePageRequested; // window.close() is called once then have to drop further requests
+    LaunchTimeline m_launchTimeline;
+    int64_t m_lastForegroundTime;
+    int64_t m_launchTime;
+    int64_t m_restoreStart;
+    bool m_preloadMemoryRecorded;
 };
 #endif // WEBAPPBASE_H
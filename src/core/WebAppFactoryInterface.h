@@ -24,6 +24,7 @@
 #include <QtPlugin>
 
 #include "ApplicationDescription.h"
+#include "LaunchParams.h"
 
 class WebAppBase;
 class WebPageBase;
@@ -32,7 +33,7 @@ class WebAppFactoryInterface {
 public:
     virtual WebAppBase* createWebApp(QString winType, std::shared_ptr<ApplicationDescription> desc = nullptr) = 0;
     virtual WebAppBase* createWebApp(QString winType, WebPageBase* page, std::shared_ptr<ApplicationDescription> desc = nullptr) = 0;
-    virtual WebPageBase* createWebPage(QUrl url, std::shared_ptr<ApplicationDescription> desc, QString launchParams = "") = 0;
+    virtual WebPageBase* createWebPage(QUrl url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& launchParams = LaunchParams()) = 0;
 };
 
 #define WebAppFactoryInterface_iid "org.qt-project.Qt.WebAppFactoryInterface"
@@ -114,7 +114,7 @@ WebAppBase* WebAppFactoryManager::createWebApp(QString winType, WebPageBase* pag
     return nullptr;
 }
 
-WebPageBase* WebAppFactoryManager::createWebPage(QString winType, QUrl url, std::shared_ptr<ApplicationDescription> desc, QString appType, QString launchParams)
+WebPageBase* WebAppFactoryManager::createWebPage(QString winType, QUrl url, std::shared_ptr<ApplicationDescription> desc, QString appType, const LaunchParams& launchParams)
 {
     WebPageBase *page = nullptr;
 
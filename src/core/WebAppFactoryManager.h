@@ -29,7 +29,7 @@ public:
     static WebAppFactoryManager* instance();
     WebAppBase* createWebApp(QString winType, std::shared_ptr<ApplicationDescription> desc = nullptr, QString appType = "");
     WebAppBase* createWebApp(QString winType, WebPageBase* page, std::shared_ptr<ApplicationDescription> desc = nullptr, QString appType = "");
-    WebPageBase* createWebPage(QString winType, QUrl url, std::shared_ptr<ApplicationDescription> desc, QString appType = "", QString launchParams = "");
+    WebPageBase* createWebPage(QString winType, QUrl url, std::shared_ptr<ApplicationDescription> desc, QString appType = "", const LaunchParams& launchParams = LaunchParams());
     WebAppFactoryInterface* getPluggable(QString appType);
     WebAppFactoryInterface* loadPluggable(QString appType = "");
 
@@ -16,33 +16,53 @@
 
 #include "WebAppManager.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <string>
 #include <sstream>
 #include <unistd.h>
 
-#include <QtCore/QJsonDocument>
-
+#include "AppEvictor.h"
 #include "ApplicationDescription.h"
+#include "ApplicationDescriptionCache.h"
+#include "BackgroundLifecycle.h"
+#include "CrashMonitor.h"
 #include "DeviceInfo.h"
+#include "LaunchMetrics.h"
+#include "LaunchParams.h"
+#include "LaunchPredictor.h"
+#include "LocalMemoryMonitor.h"
 #include "LogManager.h"
 #include "NetworkStatusManager.h"
+#include "OomScoreManager.h"
 #include "PlatformModuleFactory.h"
+#include "RendererPriorityManager.h"
 #include "ServiceSender.h"
+#include "SuspendDelayLearner.h"
 #include "WebAppBase.h"
 #include "WebAppFactoryManager.h"
 #include "WebAppManagerConfig.h"
 #include "WebAppManagerService.h"
 #include "WebAppManagerTracer.h"
+#include "WebAppManagerUtils.h"
 #include "WebPageBase.h"
 #include "WebProcessManager.h"
 #include "WindowTypes.h"
 
 #include "webos/public/runtime.h"
 
-static const int kContinuousReloadingLimit = 3;
+// net::ERR_FAILED; the error page shows a generic failure for it
+static const int kCrashLoopErrorCode = -2;
 const char kSecurityOriginPostfix[] = "-webos";
 
+// Give the launch that triggered a prediction time to settle first
+static const int kPredictivePreloadDelayMs = 10000;
+static const int kPredictivePreloadMinCpuIdle = 800; // 80.0%
+
+// A preload whose renderer has not been sampled yet is looked at again
+static const int kPreloadMemoryRetryMs = 5000;
+static const int kPreloadMemoryRetries = 6;
+
 WebAppManager* WebAppManager::instance()
 {
     // not a leak -- static variable initializations are only ever done once
@@ -53,9 +73,17 @@ WebAppManager* WebAppManager::instance()
 WebAppManager::WebAppManager()
     : m_deletingPages(false)
     , m_networkStatusManager(new NetworkStatusManager())
+    , m_appDescriptionCache(new ApplicationDescriptionCache())
+    , m_launchMetrics(new LaunchMetrics())
+    , m_appEvictor(new AppEvictor())
+    , m_memoryPressureHandler(new MemoryPressureHandler())
+    , m_crashMonitor(new CrashMonitor())
+    , m_suspendDelayLearner(new SuspendDelayLearner())
     , m_suspendDelay(0)
     , m_maxCustomSuspendDelay(0)
     , m_isAccessibilityEnabled(false)
+    , m_bootDone(false)
+    , m_runningAppListDirty(false)
 {
 }
 
@@ -67,8 +95,7 @@ WebAppManager::~WebAppManager()
 
 void WebAppManager::notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level)
 {
-    std::list<const WebAppBase*> appList = runningApps();
-    for (auto it = appList.begin(); it != appList.end(); ++it) {
+    for (auto it = m_appRegistry.begin(); it != m_appRegistry.end(); ++it) {
         const WebAppBase* app = *it;
         // Skip memory pressure handling on preloaded apps if chromium pressure is critical
         // (when system is on low or critical) because they will be killed anyway
@@ -85,6 +112,74 @@ void WebAppManager::notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel
     }
 }
 
+void WebAppManager::onMemoryThresholdChanged(const QString& level)
+{
+    m_memoryPressureHandler->setLevel(MemoryPressureHandler::levelFromName(level));
+}
+
+void WebAppManager::appForegrounded(WebAppBase* app)
+{
+    m_memoryPressureHandler->appForegrounded(app);
+    if (m_backgroundLifecycle)
+        m_backgroundLifecycle->restore(app);
+    scheduleRendererUpdate();
+}
+
+void WebAppManager::appBackgrounded(WebAppBase* app)
+{
+    if (m_backgroundLifecycle)
+        m_backgroundLifecycle->backgrounded(app);
+    scheduleRendererUpdate();
+}
+
+void WebAppManager::appRestored(WebAppBase* app, int64_t latencyUs)
+{
+    if (m_backgroundLifecycle)
+        m_backgroundLifecycle->restored(app, latencyUs);
+}
+
+void WebAppManager::onForegroundAppChanged(const QString& appId)
+{
+    scheduleRendererUpdate();
+}
+
+void WebAppManager::scheduleRendererUpdate(uint32_t createdPid)
+{
+    if (m_rendererPriorityManager)
+        m_rendererPriorityManager->schedule(createdPid);
+    if (m_oomScoreManager)
+        m_oomScoreManager->schedule(createdPid);
+}
+
+bool WebAppManager::evictBackgroundApps(const QString& reason)
+{
+    uint64_t budget = static_cast<uint64_t>(m_webAppManagerConfig->getEvictionBudget());
+    if (!budget || !m_webProcessManager)
+        return false;
+
+    std::vector<AppEvictor::Victim> victims = m_appEvictor->select(m_appRegistry, *m_webProcessManager, budget);
+    m_appEvictor->pressureHandled();
+    if (victims.empty()) {
+        LOG_INFO(MSGID_MEMORY_EVICT, 1, PMLOGKS("REASON", qPrintable(reason)), "No background app to close");
+        return false;
+    }
+
+    uint64_t freedKB = 0;
+    for (const AppEvictor::Victim& victim : victims) {
+        freedKB += victim.freedKB;
+        LOG_INFO(MSGID_MEMORY_EVICT, 5,
+                 PMLOGKS("APP_ID", qPrintable(victim.app->appId())),
+                 PMLOGKFV("PID", "%u", victim.pid),
+                 PMLOGKS("REASON", qPrintable(reason)),
+                 PMLOGKFV("FREED_KB", "%llu", static_cast<unsigned long long>(victim.freedKB)),
+                 PMLOGKFV("BACKGROUND_MS", "%lld", static_cast<long long>(victim.backgroundTime / 1000)),
+                 "total %llu of %llu kB", static_cast<unsigned long long>(freedKB), static_cast<unsigned long long>(budget));
+        m_appEvictor->evicted(victim);
+        closeAppInternal(victim.app);
+    }
+    return true;
+}
+
 void WebAppManager::setPlatformModules(std::unique_ptr<PlatformModuleFactory> factory)
 {
     m_webAppManagerConfig = factory->getWebAppManagerConfig();
@@ -92,6 +187,16 @@ void WebAppManager::setPlatformModules(std::unique_ptr<PlatformModuleFactory> fa
     m_webProcessManager = factory->getWebProcessManager();
     m_deviceInfo = factory->getDeviceInfo();
     m_deviceInfo->initialize();
+    m_launchPredictor.reset(new LaunchPredictor(m_webAppManagerConfig->getLaunchPredictorPath()));
+    if (m_webAppManagerConfig->isLocalMemoryMonitorEnabled())
+        m_localMemoryMonitor.reset(new LocalMemoryMonitor(1000, m_webAppManagerConfig->getMemoryLevelFile()));
+    if (m_webAppManagerConfig->isRendererPriorityEnabled())
+        m_rendererPriorityManager.reset(new RendererPriorityManager(m_webAppManagerConfig->getRendererCgroupRoot(),
+                                                                    m_webAppManagerConfig->getBackgroundRendererCpuMax()));
+    if (m_webAppManagerConfig->isOomScoreAdjEnabled())
+        m_oomScoreManager.reset(new OomScoreManager(m_webAppManagerConfig->getProcfsRoot()));
+    if (!m_webAppManagerConfig->getBackgroundTierDwell().isEmpty())
+        m_backgroundLifecycle.reset(new BackgroundLifecycle(m_webAppManagerConfig->getBackgroundTierDwell()));
 
     WebAppFactoryManager::instance();
     loadEnvironmentVariable();
@@ -150,7 +255,8 @@ bool WebAppManager::getDeviceInfo(QString name, QString &value)
     return m_deviceInfo->getDeviceInfo(name, value);
 }
 
-void WebAppManager::onRelaunchApp(const std::string& instanceId, const std::string& appId, const std::string& args, const std::string& launchingAppId)
+void WebAppManager::onRelaunchApp(const std::string& instanceId, const std::string& appId, const LaunchParams& args,
+                                  LaunchTimeline timeline, const std::string& launchingAppId)
 {
     WebAppBase* app = findAppById(QString::fromStdString(appId));
 
@@ -161,8 +267,6 @@ void WebAppManager::onRelaunchApp(const std::string& instanceId, const std::stri
 
     // Do not relaunch when preload args is setted
     // luna-send -n 1 luna://com.webos.applicationManager/launch '{"id":<AppId> "preload":<PreloadState> }'
-    QJsonDocument doc = QJsonDocument::fromJson(args.c_str());
-    QJsonObject obj = doc.object();
 
     // if this app is keepAlive and window.close() was once and relaunch now no matter preloaded, fastswitching, launch by launch API
     // need to clear the flag if it needs
@@ -170,9 +274,19 @@ void WebAppManager::onRelaunchApp(const std::string& instanceId, const std::stri
         app->setClosePageRequested(false);
 
     if (app->instanceId() == QString::fromStdString(instanceId)
-        && !obj["preload"].isString()
-        && !obj["launchedHidden"].toBool()) {
-        app->relaunch(args.c_str(), launchingAppId.c_str());
+        && !args.hasPreload()
+        && !args.launchedHidden()) {
+        timeline.setType(app->getHiddenWindow() && app->preloadState() != WebAppBase::NONE_PRELOAD
+                         ? LaunchTimeline::Preloaded : LaunchTimeline::Relaunch);
+        app->startLaunchTimeline(timeline);
+        // A discarded page has to be loaded before it can take the relaunch
+        if (m_backgroundLifecycle)
+            m_backgroundLifecycle->restore(app);
+        app->relaunch(args, launchingAppId.c_str());
+
+        if (m_launchPredictor)
+            m_launchPredictor->recordLaunch(app->appId());
+        schedulePredictivePreload();
     } else {
         LOG_INFO(MSGID_WAM_DEBUG, 2, PMLOGKS("APP_ID", qPrintable(app->appId())), PMLOGKFV("PID", "%d", app->page()->getWebProcessPID()), "Relaunch with preload option, ignore");
     }
@@ -191,15 +305,13 @@ bool WebAppManager::isDiscardCodeCacheRequired()
 bool WebAppManager::setInspectorEnable(QString & appId)
 {
      // 1. find appId from then running App List,
-    for (AppList::const_iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
-        if(appId == app->page()->appId()) {
-            LOG_DEBUG("[%s] setInspectorEnable", qPrintable(appId));
-            app->page()->setInspectorEnable();
-            return true;
-        }
-    }
-    return false;
+    WebAppBase* app = findAppById(appId);
+    if (!app)
+        return false;
+
+    LOG_DEBUG("[%s] setInspectorEnable", qPrintable(appId));
+    app->page()->setInspectorEnable();
+    return true;
 }
 
 void WebAppManager::discardCodeCache(uint32_t pid)
@@ -211,7 +323,7 @@ void WebAppManager::onShutdownEvent()
 {
 #if defined(TARGET_DESKTOP)
 
-    for (AppList::const_iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
+    for (auto it = m_appRegistry.begin(); it != m_appRegistry.end(); ++it) {
         delete (*it);
     }
 
@@ -253,22 +365,16 @@ bool WebAppManager::onPauseApp(const std::string& appId)
 
 std::list<const WebAppBase*> WebAppManager::runningApps()
 {
-    std::list<const WebAppBase*> apps;
-
-    for (AppList::const_iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        apps.push_back(*it);
-    }
-
-    return apps;
+    return std::list<const WebAppBase*>(m_appRegistry.begin(), m_appRegistry.end());
 }
 
 std::list<const WebAppBase*> WebAppManager::runningApps(uint32_t pid)
 {
     std::list<const WebAppBase*> apps;
 
-    for (AppList::const_iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
-
+    // The pid index is updated on renderProcessCreated; check the page
+    // anyway so that apps of a crashed process don't show up
+    for (WebAppBase* app : m_appRegistry.findByWebProcessPid(pid)) {
         if (app->page()->getWebProcessPID() == pid)
             apps.push_back(app);
     }
@@ -278,10 +384,11 @@ std::list<const WebAppBase*> WebAppManager::runningApps(uint32_t pid)
 
 WebAppBase* WebAppManager::onLaunchUrl(const std::string& url, QString winType,
                                        std::shared_ptr<ApplicationDescription> appDesc, const std::string& instanceId,
-                                       const std::string& args, const std::string& launchingAppId,
+                                       const LaunchParams& args, LaunchTimeline timeline, const std::string& launchingAppId,
                                        int& errCode, std::string& errMsg)
 {
     WebAppBase* app = WebAppFactoryManager::instance()->createWebApp(winType, appDesc, appDesc->subType().c_str());
+    timeline.mark(LaunchTimeline::WebAppCreated);
 
     if (!app) {
         errCode = ERR_CODE_LAUNCHAPP_UNSUPPORTED_TYPE;
@@ -289,7 +396,8 @@ WebAppBase* WebAppManager::onLaunchUrl(const std::string& url, QString winType,
         return nullptr;
     }
 
-    WebPageBase* page = WebAppFactoryManager::instance()->createWebPage(winType, QUrl(url.c_str()), appDesc, appDesc->subType().c_str(), args.c_str());
+    WebPageBase* page = WebAppFactoryManager::instance()->createWebPage(winType, QUrl(url.c_str()), appDesc, appDesc->subType().c_str(), args);
+    timeline.mark(LaunchTimeline::WebPageCreated);
 
     //set use launching time optimization true while app loading.
     page->setUseLaunchOptimization(true);
@@ -298,18 +406,37 @@ WebAppBase* WebAppManager::onLaunchUrl(const std::string& url, QString winType,
       page->setEnableBackgroundRun(appDesc->isEnableBackgroundRun());
 
     app->setAppDescription(appDesc);
-    app->setAppProperties(QString::fromStdString(args));
+    app->setAppProperties(args);
     app->setInstanceId(QString::fromStdString(instanceId));
     app->setLaunchingAppId(QString::fromStdString(launchingAppId));
     if (m_webAppManagerConfig->isCheckLaunchTimeEnabled())
       app->startLaunchTimer();
     app->attach(page);
-    app->setPreloadState(QString::fromStdString(args));
+    app->setPreloadState(args);
 
-    page->load();
+    // A minimal preload only binds the page to its window; it is loaded
+    // when the app is relaunched
+    if (app->preloadState() != WebAppBase::MINIMAL_PRELOAD) {
+        page->load();
+        timeline.mark(LaunchTimeline::LoadRequested);
+    }
     webPageAdded(page);
 
-    m_appList.push_back(app);
+    // Hidden and preload launches are not user visible, don't time them
+    if (!app->getHiddenWindow()) {
+        timeline.setType(m_appVersion.find(appDesc->id()) != m_appVersion.end()
+                         ? LaunchTimeline::Warm : LaunchTimeline::Cold);
+        app->startLaunchTimeline(timeline);
+
+        if (m_launchPredictor)
+            m_launchPredictor->recordLaunch(app->appId());
+        schedulePredictivePreload();
+    }
+
+    m_appRegistry.add(app);
+
+    if (app->preloadState() == WebAppBase::MINIMAL_PRELOAD)
+        recordPreloadMemory(app);
 
     if (m_appVersion.find(appDesc->id()) != m_appVersion.end()) {
       if (m_appVersion[appDesc->id()] != appDesc->version()) {
@@ -357,7 +484,6 @@ void WebAppManager::closeAppInternal(WebAppBase* app, bool ignoreCleanResource)
     webPageRemoved(app->page());
     removeWebAppFromWebProcessInfoMap(app->appId());
     postRunningAppList();
-    m_lastCrashedAppIds = QMap<QString, int>();
 
     // Set m_isClosing flag first, this flag will be checked in web page suspending
     page->setClosing(true);
@@ -388,12 +514,13 @@ bool WebAppManager::closeAllApps(uint32_t pid)
 {
     AppList runningApps;
 
-    for (AppList::iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
-        if (!pid)
-            runningApps.insert(runningApps.end(), app);
-        else if (m_webProcessManager->getWebProcessPID(app) == pid)
-            runningApps.insert(runningApps.end(), app);
+    if (!pid) {
+        runningApps.assign(m_appRegistry.begin(), m_appRegistry.end());
+    } else {
+        for (WebAppBase* app : m_appRegistry.findByWebProcessPid(pid)) {
+            if (m_webProcessManager->getWebProcessPID(app) == pid)
+                runningApps.insert(runningApps.end(), app);
+        }
     }
 
     AppList::iterator it = runningApps.begin();
@@ -436,26 +563,12 @@ void WebAppManager::removeWebAppFromWebProcessInfoMap(QString appId)
 
 WebAppBase* WebAppManager::findAppById(const QString& appId)
 {
-    for (AppList::iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
-
-        if (app->page() && app->appId() == appId)
-            return app;
-    }
-
-    return 0;
+    return m_appRegistry.findById(appId);
 }
 
 WebAppBase* WebAppManager::findAppByInstanceId(const QString& instanceId)
 {
-    for (AppList::iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
-
-        if (app->page() && (app->instanceId() == instanceId))
-            return app;
-    }
-
-    return 0;
+    return m_appRegistry.findByInstanceId(instanceId);
 }
 
 void WebAppManager::appDeleted(WebAppBase* app)
@@ -464,13 +577,29 @@ void WebAppManager::appDeleted(WebAppBase* app)
         return;
 
     std::string appId;
-    if (app->page())
+    uint32_t pid = 0;
+    if (app->page()) {
         appId = app->appId().toStdString();
+        if (m_webProcessManager)
+            pid = m_webProcessManager->getWebProcessPID(app);
+    }
 
-    m_appList.remove(app);
+    m_appRegistry.remove(app);
+    m_memoryPressureHandler->appDeleted(app);
+    m_crashMonitor->closed(app->appId());
+    if (m_backgroundLifecycle)
+        m_backgroundLifecycle->appDeleted(app);
+    scheduleRendererUpdate();
 
-    if (!appId.empty())
+    // Reclaim the renderer once the last app on it is gone
+    if (pid && m_appRegistry.findByWebProcessPid(pid).empty())
+        m_webProcessManager->requestKillWebProcess(pid, m_webProcessManager->getProcessKey(app->getAppDescription()));
+
+    if (!appId.empty()) {
         m_shellPageMap.remove(appId);
+        if (m_launchPredictor)
+            m_launchPredictor->closed(app->appId());
+    }
 }
 
 void WebAppManager::setSystemLanguage(QString language)
@@ -479,11 +608,8 @@ void WebAppManager::setSystemLanguage(QString language)
 
     m_deviceInfo->setSystemLanguage(language);
 
-    for (AppList::const_iterator it = m_appList.begin(); it != m_appList.end(); ++it)
-    {
-        WebAppBase* app = (*it);
+    for (WebAppBase* app : m_appRegistry)
         app->setPreferredLanguages(language);
-    }
 
     LOG_DEBUG("New system language: %s", language.toStdString().c_str());
 }
@@ -502,10 +628,26 @@ void WebAppManager::setDeviceInfo(QString name, QString value)
 
 void WebAppManager::broadcastWebAppMessage(WebAppMessageType type, const QString& message)
 {
-    for (AppList::const_iterator it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
+    for (WebAppBase* app : m_appRegistry)
         app->handleWebAppMessage(type, message);
-    }
+}
+
+int WebAppManager::learnedSuspendDelay(const QString& appId)
+{
+    // Memory is worth more than a quick return now
+    if (memoryPressureLevel() != MemoryPressureHandler::LevelNormal)
+        return m_suspendDelay;
+    return m_suspendDelayLearner->delay(appId, m_suspendDelay, m_maxCustomSuspendDelay);
+}
+
+void WebAppManager::suspendDelayStarted(const QString& appId, int delayMs)
+{
+    m_suspendDelayLearner->hidden(appId, m_suspendDelay, delayMs);
+}
+
+void WebAppManager::suspendDelayEnded(const QString& appId, bool suspended)
+{
+    m_suspendDelayLearner->shown(appId, suspended);
 }
 
 bool WebAppManager::processCrashed(QString appId) {
@@ -513,21 +655,33 @@ bool WebAppManager::processCrashed(QString appId) {
     if (!app)
         return false;
 
+    uint32_t pid = m_appRegistry.webProcessPid(app);
+    if (m_oomScoreManager)
+        m_oomScoreManager->processCrashed(pid);
+
+    CrashMonitor::Crash crash;
+    crash.appId = appId;
+    crash.key = m_webProcessManager ? m_webProcessManager->getProcessKey(app->getAppDescription()) : QString();
+    crash.pid = pid;
+    crash.time = LaunchTimeline::now();
+    crash.sinceLaunch = crash.time - app->launchTime();
+    crash.pssKB = 0;
+    crash.visible = app->isActivated();
+    std::shared_ptr<const ProcessSnapshot> snapshot = m_webProcessManager ? m_webProcessManager->processSnapshot() : nullptr;
+    if (const ProcessSample* sample = snapshot && pid ? snapshot->latest(pid) : nullptr)
+        crash.pssKB = sample->pss;
+
+    int reloadDelay = 0;
+    CrashMonitor::Action action = m_crashMonitor->crashed(crash, reloadDelay);
+
     if (app->isWindowed()) {
-        if (app->isActivated()) {
-            int count = m_lastCrashedAppIds[app->appId()];
-            m_lastCrashedAppIds[app->appId()] = count + 1;
-
-            int reloadingLimit = app->isNormal() ? kContinuousReloadingLimit-1 : kContinuousReloadingLimit;
-
-            if (m_lastCrashedAppIds[app->appId()] >= reloadingLimit) {
-                LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InForeground", "true"), PMLOGKS("Reloading limit", "Close app"),  "");
-                closeAppInternal(app, true);
-            }
-            else {
-                LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InForeground", "true"), PMLOGKS("Reloading limit", "OK; Reload default page"),  "");
-                app->page()->reloadDefaultPage();
-            }
+        if (action == CrashMonitor::Quarantine) {
+            LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("Reloading limit", "Crash loop; Load error page"),  "");
+            app->page()->showErrorPage(kCrashLoopErrorCode);
+        }
+        else if (app->isActivated()) {
+            LOG_INFO(MSGID_WEBPROC_CRASH, 3, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InForeground", "true"), PMLOGKS("Reloading limit", "OK; Reload default page"),  "");
+            m_crashMonitor->scheduleReload(appId, reloadDelay);
         }
         else if (app->isMinimized()) {
             LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId)), PMLOGKS("InBackground", "Will be Reloaded in Relaunch"),  "");
@@ -571,7 +725,8 @@ void WebAppManager::setForceCloseApp(QString appId)
 
 void WebAppManager::requestKillWebProcess(uint32_t pid)
 {
-    // Deprecated (2016-0401)
+    if (m_webProcessManager)
+        m_webProcessManager->requestKillWebProcess(pid);
 }
 
 void WebAppManager::deleteStorageData(const QString& identifier)
@@ -587,20 +742,22 @@ void WebAppManager::killCustomPluginProcess(const QString &basePath)
 /**
  * Launch an application (webApps only, not native).
  *
- * @param appId The application ID to launch.
- * @param params The call parameters.
+ * @param appDesc The application description of the app to launch.
+ * @param params The call parameters, parsed once by the caller.
+ * @param timeline The launch timeline, started when the request was received.
  * @param the ID of the application performing the launch (can be NULL).
  * @param errMsg The error message (will be empty if this call was successful).
  *
  * @todo: this should now be moved private and be protected...leaving it for now as to not break stuff and make things
  * slightly faster for intra-sysmgr mainloop launches
  */
-std::string WebAppManager::launch(const std::string& appDescString, const std::string& params,
-        const std::string& launchingAppId, int& errCode, std::string& errMsg)
+std::string WebAppManager::launch(const QJsonObject& appDesc, const LaunchParams& params,
+        LaunchTimeline timeline, const std::string& launchingAppId, int& errCode, std::string& errMsg)
 {
-    std::shared_ptr<ApplicationDescription> desc(ApplicationDescription::fromJsonString(appDescString.c_str()));
+    std::shared_ptr<ApplicationDescription> desc(m_appDescriptionCache->get(appDesc));
     if (!desc)
         return std::string();
+    timeline.mark(LaunchTimeline::DescriptionParsed);
 
     std::string instanceId = "";
     std::string url = desc->entryPoint();
@@ -608,44 +765,49 @@ std::string WebAppManager::launch(const std::string& appDescString, const std::s
     errMsg.erase();
 
     // Set displayAffinity (multi display support)
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray(params.c_str()));
-    QJsonObject jsonObject = jsonDoc.object();
-    if (!jsonObject.value("displayAffinity").isUndefined())
-      desc->setDisplayAffinity(jsonObject.value("displayAffinity").toInt());
+    if (params.hasDisplayAffinity())
+      desc->setDisplayAffinity(params.displayAffinity());
+
+    if (m_webProcessManager)
+        m_webProcessManager->cancelKillWebProcess(desc.get());
 
     // Check if app is already running
     if (isRunningApp(desc->id(), instanceId)) {
-        onRelaunchApp(instanceId, desc->id().c_str(), params.c_str(), launchingAppId.c_str());
+        onRelaunchApp(instanceId, desc->id().c_str(), params, timeline, launchingAppId.c_str());
     } else {
          // Run as a normal app
         instanceId = generateInstanceId();
-        if (!onLaunchUrl(url, winType, desc, instanceId, params, launchingAppId, errCode, errMsg)) {
+        if (!onLaunchUrl(url, winType, desc, instanceId, params, timeline, launchingAppId, errCode, errMsg)) {
             return std::string();
         }
     }
 
+    // Apps of the "system" key share renderers without a group to match;
+    // cancel the kill of the renderer the page has landed on, if it has one
+    if (m_webProcessManager) {
+        WebAppBase* app = findAppByInstanceId(QString::fromStdString(instanceId));
+        if (app && app->page())
+            m_webProcessManager->cancelKillWebProcess(app->page()->getWebProcessPID());
+    }
+
     return instanceId;
 }
 
 bool WebAppManager::isRunningApp(const std::string& id, std::string& instanceId) {
-    std::list<const WebAppBase*> running = runningApps();
+    WebAppBase* app = m_appRegistry.findById(QString::fromStdString(id));
+    if (!app)
+        return false;
 
-    QString appIdToFind = QString::fromStdString(id);
-    for (auto it = running.begin(); it != running.end(); ++it) {
-        if ((*it)->appId() == appIdToFind) {
-            instanceId = (*it)->instanceId().toStdString();
-            return true;
-        }
-    }
-    return false;
+    instanceId = app->instanceId().toStdString();
+    return true;
 }
 
 std::vector<ApplicationInfo> WebAppManager::list( bool includeSystemApps )
 {
     std::vector<ApplicationInfo> list;
 
-    std::list<const WebAppBase*> running = runningApps();
-    for (auto it = running.begin(); it != running.end(); ++it) {
+    list.reserve(m_appRegistry.size());
+    for (auto it = m_appRegistry.begin(); it != m_appRegistry.end(); ++it) {
         const WebAppBase* webAppBase = *it;
         if( webAppBase->appId().size() || (!webAppBase->appId().size() && includeSystemApps ) ) {
             uint32_t pid = m_webProcessManager->getWebProcessPID(webAppBase);
@@ -656,9 +818,181 @@ std::vector<ApplicationInfo> WebAppManager::list( bool includeSystemApps )
     return list;
 }
 
+void WebAppManager::updateApplicationDescription(const QJsonObject& appDesc, bool changed)
+{
+    m_appDescriptionCache->update(appDesc, changed);
+}
+
+void WebAppManager::removeApplicationDescription(const QString& appId)
+{
+    m_appDescriptionCache->remove(appId);
+    if (m_launchPredictor)
+        m_launchPredictor->remove(appId);
+}
+
 QJsonObject WebAppManager::getWebProcessProfiling()
 {
-    return m_webProcessManager->getWebProcessProfiling();
+    QJsonObject reply = m_webProcessManager->getWebProcessProfiling();
+    reply["eviction"] = m_appEvictor->stats();
+    reply["memoryPressure"] = m_memoryPressureHandler->stats();
+    reply["crashes"] = m_crashMonitor->stats();
+    reply["suspendDelay"] = m_suspendDelayLearner->stats();
+    if (m_backgroundLifecycle)
+        reply["background"] = m_backgroundLifecycle->stats();
+    reply["timers"] = TimerWheel::instance()->stats();
+    if (m_rendererPriorityManager)
+        reply["priority"] = m_rendererPriorityManager->stats();
+    if (m_oomScoreManager)
+        reply["oomScore"] = m_oomScoreManager->stats();
+    return reply;
+}
+
+void WebAppManager::onBootDone()
+{
+    if (m_bootDone)
+        return;
+
+    m_bootDone = true;
+    if (m_webProcessManager) {
+        m_webProcessManager->prepareWebViews();
+        m_webProcessManager->prepareWindows();
+    }
+
+    schedulePredictivePreload();
+}
+
+void WebAppManager::schedulePredictivePreload()
+{
+    if (m_webAppManagerConfig->getPredictivePreloadCount() <= 0)
+        return;
+
+    m_predictivePreloadTimer.start(kPredictivePreloadDelayMs, kPredictivePreloadMinCpuIdle,
+                                   this, &WebAppManager::predictivePreload);
+}
+
+void WebAppManager::predictivePreload()
+{
+    int count = m_webAppManagerConfig->getPredictivePreloadCount();
+    if (!m_bootDone || !m_launchPredictor || m_launchPredictor->preloadedCount() >= count)
+        return;
+
+    long memAvailable = WebAppManagerUtils::getMemAvailable();
+    if (memAvailable >= 0 && memAvailable < m_webAppManagerConfig->getPredictivePreloadMinMemAvailable()) {
+        LOG_DEBUG("Predictive preload skipped; MemAvailable: %ld kB", memAvailable);
+        return;
+    }
+
+    QSet<QString> exclude;
+    for (const WebAppBase* app : m_appRegistry)
+        exclude.insert(app->appId());
+    for (const QString& appId : m_closingAppList.keys())
+        exclude.insert(appId);
+
+    QStringList predicted = m_launchPredictor->predict(count - m_launchPredictor->preloadedCount(), exclude);
+    for (const QString& appId : predicted) {
+        std::shared_ptr<ApplicationDescription> desc(m_appDescriptionCache->find(appId));
+        if (!desc)
+            continue;
+
+        QJsonObject preload;
+        preload["preload"] = QStringLiteral("partial");
+
+        int errCode = 0;
+        std::string errMsg;
+        WebAppBase* app = onLaunchUrl(desc->entryPoint(), windowTypeFromString(desc->defaultWindowType()), desc,
+                                      generateInstanceId(), LaunchParams(preload), LaunchTimeline(), std::string(),
+                                      errCode, errMsg);
+        if (!app)
+            continue;
+
+        LOG_INFO(MSGID_PREDICTIVE_PRELOAD, 2, PMLOGKS("APP_ID", qPrintable(appId)),
+                 PMLOGKFV("MEM_AVAILABLE", "%ld", memAvailable), "");
+        m_launchPredictor->preloaded(appId);
+        postRunningAppList();
+
+        // One preload per idle slot
+        schedulePredictivePreload();
+        return;
+    }
+}
+
+void WebAppManager::recordLaunchTimeline(const QString& appId, const LaunchTimeline& timeline)
+{
+    LOG_INFO(MSGID_APPLAUNCH_DONE, 2,
+             PMLOGKS("APP_ID", qPrintable(appId)),
+             PMLOGKS("TYPE", LaunchTimeline::typeName(timeline.type())),
+             "lastFrameSwapped: %d ms", static_cast<int>(timeline.elapsed(LaunchTimeline::LastFrameSwapped) / 1000));
+
+    m_launchMetrics->record(appId, timeline);
+}
+
+void WebAppManager::recordPreloadMemory(WebAppBase* app)
+{
+    if (!app->page() || app->preloadState() == WebAppBase::NONE_PRELOAD)
+        return;
+
+    if (app->preloadMemoryRecorded() || !m_webProcessManager)
+        return;
+
+    // The app's share of its renderer's PSS, once per preload. A minimal
+    // preload is not loaded and may not have a renderer (sample) yet.
+    uint32_t pid = app->page()->getWebProcessPID();
+    std::shared_ptr<const ProcessSnapshot> snapshot = m_webProcessManager->processSnapshot();
+    const ProcessSample* sample = snapshot && pid ? snapshot->latest(pid) : nullptr;
+    if (!sample) {
+        if (!m_pendingPreloadMemory.contains(app->instanceId()))
+            m_pendingPreloadMemory.insert(app->instanceId(), kPreloadMemoryRetries);
+        if (!m_preloadMemoryTimer.isRunning())
+            m_preloadMemoryTimer.start(kPreloadMemoryRetryMs, this, &WebAppManager::recordPendingPreloadMemory);
+        return;
+    }
+
+    int apps = 0;
+    for (WebAppBase* other : m_appRegistry.findByWebProcessPid(pid)) {
+        if (other->page() && other->page()->getWebProcessPID() == pid)
+            apps++;
+    }
+    int64_t sizeKB = static_cast<int64_t>(sample->pss) / std::max(apps, 1);
+
+    app->setPreloadMemoryRecorded(true);
+    m_pendingPreloadMemory.remove(app->instanceId());
+
+    const char* level = WebAppBase::preloadStateName(app->preloadState());
+    LOG_INFO(MSGID_WAM_DEBUG, 3,
+             PMLOGKS("APP_ID", qPrintable(app->appId())),
+             PMLOGKFV("PID", "%d", pid),
+             PMLOGKS("PRELOAD", level),
+             "Preloaded; pss share: %lld kB (%d apps)", static_cast<long long>(sizeKB), apps);
+
+    m_launchMetrics->recordPreloadMemory(app->appId(), level, sizeKB);
+}
+
+void WebAppManager::recordPendingPreloadMemory()
+{
+    QHash<QString, int> pending;
+    pending.swap(m_pendingPreloadMemory);
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        WebAppBase* app = m_appRegistry.findByInstanceId(it.key());
+        if (!app || app->preloadState() == WebAppBase::NONE_PRELOAD || it.value() <= 1)
+            continue;
+
+        // Put back with one look less unless it gets recorded now
+        m_pendingPreloadMemory.insert(it.key(), it.value() - 1);
+        recordPreloadMemory(app);
+    }
+}
+
+QJsonObject WebAppManager::getLaunchMetrics(const QString& appId)
+{
+    QJsonObject metrics = m_launchMetrics->toJson(appId);
+    if (m_launchPredictor)
+        metrics["predictor"] = m_launchPredictor->metrics();
+    if (m_webProcessManager) {
+        QJsonObject windowPool = m_webProcessManager->windowPoolStats();
+        if (!windowPool.isEmpty())
+            metrics["windowPool"] = windowPool;
+    }
+    return metrics;
 }
 
 void WebAppManager::closeApp(const std::string& appId)
@@ -672,12 +1006,39 @@ void WebAppManager::postRunningAppList()
     if (!m_serviceSender)
         return;
 
+    // Launches, closes and renderer changes of one main loop iteration
+    // (killApps, eviction, pages finishing cleanup) go out as one update
+    m_runningAppListDirty = true;
+    if (!m_runningAppListTimer.isRunning())
+        m_runningAppListTimer.start(0, this, &WebAppManager::flushRunningAppList);
+}
+
+void WebAppManager::flushRunningAppList()
+{
+    if (!m_runningAppListDirty)
+        return;
+
+    m_runningAppListDirty = false;
     std::vector<ApplicationInfo> apps = list(true);
     m_serviceSender->postlistRunningApps(apps);
 }
 
 void WebAppManager::postWebProcessCreated(const QString& appId, uint32_t pid)
 {
+    if (m_webProcessManager) {
+        m_webProcessManager->watchWebProcess(pid);
+        m_webProcessManager->cancelKillWebProcess(pid);
+    }
+    scheduleRendererUpdate(pid);
+
+    // Every instance of the app may have been moved to a new renderer
+    for (WebAppBase* app : m_appRegistry) {
+        if (app->appId() != appId || !app->page() || app->page()->getWebProcessPID() != pid)
+            continue;
+        m_appRegistry.updateWebProcessPid(app, pid);
+        app->markLaunchPhase(LaunchTimeline::RenderProcessCreated);
+    }
+
     if (!m_serviceSender)
         return;
 
@@ -687,6 +1048,15 @@ void WebAppManager::postWebProcessCreated(const QString& appId, uint32_t pid)
         m_serviceSender->postWebProcessCreated(appId, pid);
 }
 
+void WebAppManager::pageRecreated(WebAppBase* app)
+{
+    // The new web view may not have a renderer yet; postWebProcessCreated
+    // fills the pid in once it has
+    m_appRegistry.refreshWebProcessPid(app);
+    if (m_webProcessManager && app->page())
+        m_webProcessManager->cancelKillWebProcess(app->page()->getWebProcessPID());
+}
+
 uint32_t WebAppManager::getWebProcessId(const QString& appId)
 {
     uint32_t pid = 0;
@@ -712,7 +1082,7 @@ void WebAppManager::setAccessibilityEnabled(bool enabled)
     if (m_isAccessibilityEnabled == enabled)
         return;
 
-    for (auto it = m_appList.begin(); it != m_appList.end(); ++it) {
+    for (auto it = m_appRegistry.begin(); it != m_appRegistry.end(); ++it) {
         //set audion guidance on/off on settings app
         if ((*it)->page())
             (*it)->page()->setAudioGuidanceOn(enabled);
@@ -722,14 +1092,13 @@ void WebAppManager::setAccessibilityEnabled(bool enabled)
     m_isAccessibilityEnabled = enabled;
 }
 
-void WebAppManager::sendEventToAllAppsAndAllFrames(const QString& jsscript)
+void WebAppManager::sendEventToAllAppsAndAllFrames(const QString& type, const QString& jsscript)
 {
-    for (auto it = m_appList.begin(); it != m_appList.end(); ++it) {
-        WebAppBase* app = (*it);
+    for (WebAppBase* app : m_appRegistry) {
         if (app->page()) {
-            LOG_DEBUG("[%s] send event with %s", qPrintable(app->appId()), qPrintable(jsscript));
-            // to send all subFrame, use this function instead of evaluateJavaScriptInAllFrames()
-            app->page()->evaluateJavaScriptInAllFrames(jsscript);
+            LOG_DEBUG("[%s] send %s event with %s", qPrintable(app->appId()), qPrintable(type), qPrintable(jsscript));
+            // to send all subFrame, use this function instead of evaluateJavaScript()
+            app->page()->sendEvent(type, jsscript, true);
         }
     }
 }
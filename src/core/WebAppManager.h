@@ -23,17 +23,35 @@
 #include <string>
 #include <vector>
 
+#include <QHash>
 #include <QJsonObject>
 #include <QMultiMap>
 #include <QString>
 
 #include "webos/webview_base.h"
 
+#include "LaunchTimeline.h"
+#include "MemoryPressureHandler.h"
+#include "IdleTimer.h"
+#include "Timer.h"
+#include "WebAppRegistry.h"
+
+class AppEvictor;
+class BackgroundLifecycle;
 class ApplicationDescription;
+class ApplicationDescriptionCache;
+class CrashMonitor;
 class DeviceInfo;
+class LaunchMetrics;
+class LaunchParams;
+class LaunchPredictor;
+class LocalMemoryMonitor;
+class OomScoreManager;
+class RendererPriorityManager;
 class NetworkStatusManager;
 class PlatformModuleFactory;
 class ServiceSender;
+class SuspendDelayLearner;
 class WebProcessManager;
 class WebAppManagerConfig;
 class WebAppBase;
@@ -78,16 +96,27 @@ public:
     std::list<const WebAppBase*> runningApps(uint32_t pid);
     WebAppBase* findAppById(const QString& appId);
     WebAppBase* findAppByInstanceId(const QString& instanceId);
+    // Running apps in launch order; iterating it does not copy anything
+    const WebAppRegistry& appRegistry() const { return m_appRegistry; }
 
-    std::string launch(const std::string& appDescString,
-        const std::string& params,
+    std::string launch(const QJsonObject& appDesc,
+        const LaunchParams& params,
+        LaunchTimeline timeline,
         const std::string& launchingAppId,
         int& errCode,
         std::string& errMsg);
 
     std::vector<ApplicationInfo> list(bool includeSystemApps = false);
 
+    void updateApplicationDescription(const QJsonObject& appDesc, bool changed = false);
+    void removeApplicationDescription(const QString& appId);
+
     QJsonObject getWebProcessProfiling();
+    void onBootDone();
+    bool isBootDone() const { return m_bootDone; }
+    void recordLaunchTimeline(const QString& appId, const LaunchTimeline& timeline);
+    void recordPreloadMemory(WebAppBase* app);
+    QJsonObject getLaunchMetrics(const QString& appId);
     int currentUiWidth();
     int currentUiHeight();
     void setUiSize(int width, int height);
@@ -116,6 +145,10 @@ public:
 
     int getSuspendDelay() { return m_suspendDelay; }
     int getMaxCustomSuspendDelay() const { return m_maxCustomSuspendDelay; }
+    // Suspend delay learned for |appId|; the base delay under memory pressure
+    int learnedSuspendDelay(const QString& appId);
+    void suspendDelayStarted(const QString& appId, int delayMs);
+    void suspendDelayEnded(const QString& appId, bool suspended);
     void deleteStorageData(const QString& identifier);
     void killCustomPluginProcess(const QString& basePath);
     bool processCrashed(QString appId);
@@ -128,6 +161,7 @@ public:
     void removeWebAppFromWebProcessInfoMap(QString appId);
 
     void appDeleted(WebAppBase* app);
+    // Posted on the next main loop iteration, once for all changes until then
     void postRunningAppList();
     std::string generateInstanceId();
     void removeClosingAppList(const QString& appId);
@@ -135,11 +169,24 @@ public:
     bool isAccessibilityEnabled() { return m_isAccessibilityEnabled; }
     void setAccessibilityEnabled(bool enabled);
     void postWebProcessCreated(const QString& appId, uint32_t pid);
+    // The web view of |app| was replaced (renderer crash or discard)
+    void pageRecreated(WebAppBase* app);
     uint32_t getWebProcessId(const QString& appId);
-    void sendEventToAllAppsAndAllFrames(const QString& jsscript);
+    void sendEventToAllAppsAndAllFrames(const QString& type, const QString& jsscript);
     void serviceCall(const QString& url, const QString& payload, const QString& appId);
     void updateNetworkStatus(const QJsonObject& object);
     void notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level);
+    // |level| is a memory manager level: "normal", "medium", "low" or "critical"
+    void onMemoryThresholdChanged(const QString& level);
+    // Closes background apps until the eviction budget is covered; false if none was
+    bool evictBackgroundApps(const QString& reason);
+    void appForegrounded(WebAppBase* app);
+    void appBackgrounded(WebAppBase* app);
+    // First frame of |app| since it was brought back from a background tier
+    void appRestored(WebAppBase* app, int64_t latencyUs);
+    // |appId| is in the foreground now, whether it is a web app or not
+    void onForegroundAppChanged(const QString& appId);
+    MemoryPressureHandler::Level memoryPressureLevel() const { return m_memoryPressureHandler->level(); }
 
     bool isEnyoApp(const QString& appId);
 
@@ -156,10 +203,10 @@ private:
 
     WebAppBase* onLaunchUrl(const std::string& url, QString winType,
         std::shared_ptr<ApplicationDescription> appDesc, const std::string& instanceId,
-        const std::string& args, const std::string& launchingAppId,
+        const LaunchParams& args, LaunchTimeline timeline, const std::string& launchingAppId,
         int& errCode, std::string& errMsg);
     void onRelaunchApp(const std::string& instanceId, const std::string& appId,
-        const std::string& args, const std::string& launchingAppId);
+        const LaunchParams& args, LaunchTimeline timeline, const std::string& launchingAppId);
 
     WebAppManager();
 
@@ -168,11 +215,20 @@ private:
 
     bool isRunningApp(const std::string& id, std::string& instanceId);
 
+    // Renderers' priorities and OOM scores follow the apps on them;
+    // |createdPid| is a renderer that has just come up
+    void scheduleRendererUpdate(uint32_t createdPid = 0);
+
+    void schedulePredictivePreload();
+    void predictivePreload();
+    void recordPendingPreloadMemory();
+    void flushRunningAppList();
+
     QMap<QString, WebAppBase*> m_closingAppList;
 
     // Mappings
     QMap<std::string, WebPageBase*> m_shellPageMap;
-    AppList m_appList;
+    WebAppRegistry m_appRegistry;
     QMultiMap<std::string, WebPageBase*> m_appPageMap;
 
     PageList m_pagesToDeleteList;
@@ -185,8 +241,23 @@ private:
     std::unique_ptr<DeviceInfo> m_deviceInfo;
     std::unique_ptr<WebAppManagerConfig> m_webAppManagerConfig;
     std::unique_ptr<NetworkStatusManager> m_networkStatusManager;
+    std::unique_ptr<ApplicationDescriptionCache> m_appDescriptionCache;
+    std::unique_ptr<LaunchMetrics> m_launchMetrics;
+    std::unique_ptr<LaunchPredictor> m_launchPredictor;
+    IdleTimer<WebAppManager> m_predictivePreloadTimer;
+    // Preloads (by instance id) waiting for a sample of their renderer,
+    // with the number of looks left
+    QHash<QString, int> m_pendingPreloadMemory;
+    OneShotTimer<WebAppManager> m_preloadMemoryTimer;
+    std::unique_ptr<AppEvictor> m_appEvictor;
+    std::unique_ptr<LocalMemoryMonitor> m_localMemoryMonitor;
+    std::unique_ptr<MemoryPressureHandler> m_memoryPressureHandler;
+    std::unique_ptr<RendererPriorityManager> m_rendererPriorityManager;
+    std::unique_ptr<OomScoreManager> m_oomScoreManager;
+    std::unique_ptr<CrashMonitor> m_crashMonitor;
+    std::unique_ptr<BackgroundLifecycle> m_backgroundLifecycle;
+    std::unique_ptr<SuspendDelayLearner> m_suspendDelayLearner;
 
-    QMap<QString, int> m_lastCrashedAppIds;
 
     int m_suspendDelay;
     int m_maxCustomSuspendDelay;
@@ -194,6 +265,9 @@ private:
     std::map<std::string, std::string> m_appVersion;
 
     bool m_isAccessibilityEnabled;
+    bool m_bootDone;
+    bool m_runningAppListDirty;
+    OneShotTimer<WebAppManager> m_runningAppListTimer;
 };
 
 #endif /* WEBAPPMANAGER_H */
@@ -28,6 +28,16 @@ WebAppManagerConfig::WebAppManagerConfig()
     , m_checkLaunchTimeEnabled(false)
     , m_useSystemAppOptimization(false)
     , m_launchOptimizationEnabled(false)
+    , m_webViewPoolSize(1)
+    , m_windowPoolSize(1)
+    , m_predictivePreloadCount(0)
+    , m_predictivePreloadMinMemAvailable(256 * 1024)
+    , m_processSamplingInterval(1000)
+    , m_webProcessKillGracePeriod(5000)
+    , m_evictionBudget(64 * 1024)
+    , m_localMemoryMonitorEnabled(false)
+    , m_rendererPriorityEnabled(false)
+    , m_oomScoreAdjEnabled(true)
 {
     initConfiguration();
 }
@@ -73,6 +83,70 @@ void WebAppManagerConfig::initConfiguration()
         m_userScriptPath = QLatin1String("webOSUserScripts/userScript.js");
 
     m_name = qgetenv("WAM_NAME").data();
+
+    QByteArray webViewPoolSize = qgetenv("WAM_WEBVIEW_POOL_SIZE");
+    if (!webViewPoolSize.isEmpty())
+        m_webViewPoolSize = std::max(webViewPoolSize.toInt(), 0);
+
+    QByteArray windowPoolSize = qgetenv("WAM_WINDOW_POOL_SIZE");
+    if (!windowPoolSize.isEmpty())
+        m_windowPoolSize = std::max(windowPoolSize.toInt(), 0);
+
+    m_launchPredictorPath = QLatin1String(qgetenv("WAM_LAUNCH_PREDICTOR_PATH"));
+    if (m_launchPredictorPath.isEmpty())
+        m_launchPredictorPath = QLatin1String("/var/lib/wam/launchPredictor.json");
+
+    // Predictive preloading is off unless a number of apps is given
+    QByteArray predictivePreloadCount = qgetenv("WAM_PREDICTIVE_PRELOAD_COUNT");
+    if (!predictivePreloadCount.isEmpty())
+        m_predictivePreloadCount = std::max(predictivePreloadCount.toInt(), 0);
+
+    QByteArray predictivePreloadMinMem = qgetenv("WAM_PREDICTIVE_PRELOAD_MIN_MEM_KB");
+    if (!predictivePreloadMinMem.isEmpty())
+        m_predictivePreloadMinMemAvailable = predictivePreloadMinMem.toLong();
+
+    // 0 turns the background sampler off
+    QByteArray processSamplingInterval = qgetenv("WAM_PROC_SAMPLING_INTERVAL_MS");
+    if (!processSamplingInterval.isEmpty())
+        m_processSamplingInterval = std::max(processSamplingInterval.toInt(), 0);
+
+    QByteArray webProcessKillGracePeriod = qgetenv("WAM_WEBPROCESS_KILL_GRACE_MS");
+    if (!webProcessKillGracePeriod.isEmpty())
+        m_webProcessKillGracePeriod = std::max(webProcessKillGracePeriod.toInt(), 0);
+
+    // kB to recover by closing background apps on memory pressure, 0 disables it
+    QByteArray evictionBudget = qgetenv("WAM_EVICTION_BUDGET_KB");
+    if (!evictionBudget.isEmpty())
+        m_evictionBudget = std::max(evictionBudget.toInt(), 0);
+
+    if (qgetenv("WAM_LOCAL_MEMORY_MONITOR") == "1")
+        m_localMemoryMonitorEnabled = true;
+    m_memoryLevelFile = QLatin1String(qgetenv("WAM_MEMORY_LEVEL_FILE"));
+
+    if (qgetenv("WAM_RENDERER_PRIORITY") == "1")
+        m_rendererPriorityEnabled = true;
+
+    // A cgroup v2 directory WAM may create groups in; any directory will do for testing
+    m_rendererCgroupRoot = QLatin1String(qgetenv("WAM_RENDERER_CGROUP_ROOT"));
+    if (m_rendererCgroupRoot.isEmpty())
+        m_rendererCgroupRoot = QLatin1String("/sys/fs/cgroup/wam");
+
+    // cpu.max of background renderers: 20% of a cpu unless told otherwise
+    m_backgroundRendererCpuMax = QLatin1String(qgetenv("WAM_BACKGROUND_RENDERER_CPU_MAX"));
+    if (m_backgroundRendererCpuMax.isEmpty())
+        m_backgroundRendererCpuMax = QLatin1String("20000 100000");
+
+    if (qgetenv("WAM_OOM_SCORE_ADJ") == "0")
+        m_oomScoreAdjEnabled = false;
+
+    m_procfsRoot = QLatin1String(qgetenv("WAM_PROCFS_ROOT"));
+    if (m_procfsRoot.isEmpty())
+        m_procfsRoot = QLatin1String("/proc");
+
+    // ms a hidden app spends with its media suspended, its DOM suspended and
+    // its compositor deactivated before moving on, e.g. "5000,60000,600000";
+    // 0 keeps it in that tier. Unset, hidden apps are not moved at all
+    m_backgroundTierDwell = QLatin1String(qgetenv("WAM_BACKGROUND_TIER_DWELL_MS"));
 }
 
 QVariant WebAppManagerConfig::getConfiguration(QString name)
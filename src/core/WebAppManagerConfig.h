@@ -44,6 +44,22 @@ public:
     virtual std::string getName() const { return m_name; }
 
     virtual bool isLaunchOptimizationEnabled() const { return m_launchOptimizationEnabled; }
+    virtual int getWebViewPoolSize() const { return m_webViewPoolSize; }
+    virtual int getWindowPoolSize() const { return m_windowPoolSize; }
+    virtual QString getLaunchPredictorPath() const { return m_launchPredictorPath; }
+    virtual int getPredictivePreloadCount() const { return m_predictivePreloadCount; }
+    virtual long getPredictivePreloadMinMemAvailable() const { return m_predictivePreloadMinMemAvailable; }
+    virtual int getProcessSamplingInterval() const { return m_processSamplingInterval; }
+    virtual int getWebProcessKillGracePeriod() const { return m_webProcessKillGracePeriod; }
+    virtual int getEvictionBudget() const { return m_evictionBudget; }
+    virtual bool isLocalMemoryMonitorEnabled() const { return m_localMemoryMonitorEnabled; }
+    virtual QString getMemoryLevelFile() const { return m_memoryLevelFile; }
+    virtual bool isRendererPriorityEnabled() const { return m_rendererPriorityEnabled; }
+    virtual QString getRendererCgroupRoot() const { return m_rendererCgroupRoot; }
+    virtual QString getBackgroundRendererCpuMax() const { return m_backgroundRendererCpuMax; }
+    virtual bool isOomScoreAdjEnabled() const { return m_oomScoreAdjEnabled; }
+    virtual QString getProcfsRoot() const { return m_procfsRoot; }
+    virtual QString getBackgroundTierDwell() const { return m_backgroundTierDwell; }
 
 protected:
     virtual QVariant getConfiguration(QString name);
@@ -68,6 +84,22 @@ private:
     bool m_launchOptimizationEnabled;
     QString m_userScriptPath;
     std::string m_name;
+    int m_webViewPoolSize;
+    int m_windowPoolSize;
+    QString m_launchPredictorPath;
+    int m_predictivePreloadCount;
+    long m_predictivePreloadMinMemAvailable;
+    int m_processSamplingInterval;
+    int m_webProcessKillGracePeriod;
+    int m_evictionBudget;
+    bool m_localMemoryMonitorEnabled;
+    QString m_memoryLevelFile;
+    bool m_rendererPriorityEnabled;
+    QString m_rendererCgroupRoot;
+    QString m_backgroundRendererCpuMax;
+    bool m_oomScoreAdjEnabled;
+    QString m_procfsRoot;
+    QString m_backgroundTierDwell;
 
     QMap<QString, QVariant> m_configuration;
 };
@@ -24,10 +24,10 @@ WebAppManagerService::WebAppManagerService()
 {
 }
 
-std::string WebAppManagerService::onLaunch(const std::string& appDescString, const std::string& params,
-        const std::string& launchingAppId, int& errCode, std::string& errMsg)
+std::string WebAppManagerService::onLaunch(const QJsonObject& appDesc, const LaunchParams& params,
+        const LaunchTimeline& timeline, const std::string& launchingAppId, int& errCode, std::string& errMsg)
 {
-    return WebAppManager::instance()->launch(appDescString, params, launchingAppId, errCode, errMsg);
+    return WebAppManager::instance()->launch(appDesc, params, timeline, launchingAppId, errCode, errMsg);
 }
 
 bool WebAppManagerService::onKillApp(const std::string& appId, bool force)
@@ -80,6 +80,11 @@ QJsonObject WebAppManagerService::getWebProcessProfiling()
     return WebAppManager::instance()->getWebProcessProfiling();
 }
 
+QJsonObject WebAppManagerService::launchMetrics(const QString& appId)
+{
+    return WebAppManager::instance()->getLaunchMetrics(appId);
+}
+
 void WebAppManagerService::onClearBrowsingData(const int removeBrowsingDataMask)
 {
     WebAppManager::instance()->clearBrowsingData(removeBrowsingDataMask);
@@ -127,6 +132,21 @@ void WebAppManagerService::requestKillWebProcess(uint32_t pid)
     WebAppManager::instance()->requestKillWebProcess(pid);
 }
 
+void WebAppManagerService::onBootDone()
+{
+    WebAppManager::instance()->onBootDone();
+}
+
+void WebAppManagerService::updateApplicationDescription(const QJsonObject& appDesc, bool changed)
+{
+    WebAppManager::instance()->updateApplicationDescription(appDesc, changed);
+}
+
+void WebAppManagerService::removeApplicationDescription(const QString& appId)
+{
+    WebAppManager::instance()->removeApplicationDescription(appId);
+}
+
 std::list<const WebAppBase*> WebAppManagerService::runningApps()
 {
     return WebAppManager::instance()->runningApps();
@@ -187,6 +207,16 @@ void WebAppManagerService::notifyMemoryPressure(webos::WebViewBase::MemoryPressu
     WebAppManager::instance()->notifyMemoryPressure(level);
 }
 
+void WebAppManagerService::onMemoryThresholdChanged(const QString& level)
+{
+    WebAppManager::instance()->onMemoryThresholdChanged(level);
+}
+
+void WebAppManagerService::onForegroundAppChanged(const QString& appId)
+{
+    WebAppManager::instance()->onForegroundAppChanged(appId);
+}
+
 bool WebAppManagerService::isEnyoApp(const QString& appId)
 {
     return WebAppManager::instance()->isEnyoApp(appId);
@@ -30,7 +30,8 @@ enum ErrorCode {
     ERR_CODE_NO_RUNNING_APP = 2000,
     ERR_CODE_CLEAR_DATA_BRAWSING_EMPTY_ARRAY = 3000,
     ERR_CODE_CLEAR_DATA_BRAWSING_INVALID_VALUE = 3001,
-    ERR_CODE_CLEAR_DATA_BRAWSING_UNKNOWN_DATA = 3002
+    ERR_CODE_CLEAR_DATA_BRAWSING_UNKNOWN_DATA = 3002,
+    ERR_CODE_BATCH_MISS_ITEMS = 4000
 };
 
 const std::string err_missParam = "Miss launch parameter(s)";
@@ -44,6 +45,10 @@ const std::string err_invalidValue = "Invalid value";
 const std::string err_unknownData = "Unknown data";
 const std::string err_onlyAllowedForString = "Only allowed for string type";
 
+const std::string err_missItems = "Miss array of items";
+
+class LaunchParams;
+class LaunchTimeline;
 class WebAppBase;
 
 class WebAppManagerService {
@@ -64,10 +69,15 @@ public:
     virtual QJsonObject getWebProcessSize(QJsonObject request) = 0;
     virtual QJsonObject clearBrowsingData(QJsonObject request) = 0;
     virtual QJsonObject webProcessCreated(QJsonObject request, bool subscribed) = 0;
+    virtual QJsonObject getLaunchMetrics(QJsonObject request) = 0;
+    virtual QJsonObject launchApps(QJsonObject request) = 0;
+    virtual QJsonObject killApps(QJsonObject request) = 0;
+    virtual QJsonObject closeByProcessIds(QJsonObject request) = 0;
 
 protected:
-    std::string onLaunch(const std::string& appDescString,
-        const std::string& params,
+    std::string onLaunch(const QJsonObject& appDesc,
+        const LaunchParams& params,
+        const LaunchTimeline& timeline,
         const std::string& launchingAppId,
         int& errCode,
         std::string& errMsg);
@@ -80,6 +90,7 @@ protected:
     void onDiscardCodeCache(uint32_t pid);
     bool onPurgeSurfacePool(uint32_t pid);
     QJsonObject getWebProcessProfiling();
+    QJsonObject launchMetrics(const QString& appId);
     QJsonObject closeByInstanceId(QString instanceId);
     int maskForBrowsingDataType(const char* type);
     void onClearBrowsingData(const int removeBrowsingDataMask);
@@ -92,8 +103,13 @@ protected:
     void deleteStorageData(const QString& identifier);
     void killCustomPluginProcess(const QString& appBasePath);
     void requestKillWebProcess(uint32_t pid);
+    void onBootDone();
+    void updateApplicationDescription(const QJsonObject& appDesc, bool changed = false);
+    void removeApplicationDescription(const QString& appId);
     void updateNetworkStatus(const QJsonObject& object);
     void notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level);
+    void onMemoryThresholdChanged(const QString& level);
+    void onForegroundAppChanged(const QString& appId);
     void setAccessibilityEnabled(bool enable);
     uint32_t getWebProcessId(const QString& appId);
 
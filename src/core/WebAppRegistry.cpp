@@ -0,0 +1,107 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "WebAppRegistry.h"
+
+#include "WebAppBase.h"
+#include "WebPageBase.h"
+
+void WebAppRegistry::add(WebAppBase* app)
+{
+    if (!app || m_pids.contains(app))
+        return;
+
+    m_apps.push_back(app);
+
+    // Like the list lookup it replaces, an app id resolves to the
+    // earliest launched instance
+    if (!m_appsById.contains(app->appId()))
+        m_appsById.insert(app->appId(), app);
+    m_appsByInstanceId.insert(app->instanceId(), app);
+
+    uint32_t pid = app->page() ? app->page()->getWebProcessPID() : 0;
+    m_pids.insert(app, pid);
+    if (pid)
+        m_appsByPid.insert(pid, app);
+}
+
+void WebAppRegistry::remove(WebAppBase* app)
+{
+    if (!m_pids.contains(app))
+        return;
+
+    m_apps.remove(app);
+
+    if (m_appsById.value(app->appId()) == app) {
+        m_appsById.remove(app->appId());
+        for (WebAppBase* other : m_apps) {
+            if (other->appId() == app->appId()) {
+                m_appsById.insert(other->appId(), other);
+                break;
+            }
+        }
+    }
+    if (m_appsByInstanceId.value(app->instanceId()) == app)
+        m_appsByInstanceId.remove(app->instanceId());
+
+    uint32_t pid = m_pids.take(app);
+    if (pid)
+        m_appsByPid.remove(pid, app);
+}
+
+void WebAppRegistry::updateWebProcessPid(WebAppBase* app, uint32_t pid)
+{
+    auto it = m_pids.find(app);
+    if (it == m_pids.end() || it.value() == pid)
+        return;
+
+    if (it.value())
+        m_appsByPid.remove(it.value(), app);
+    it.value() = pid;
+    if (pid)
+        m_appsByPid.insert(pid, app);
+}
+
+void WebAppRegistry::refreshWebProcessPid(WebAppBase* app)
+{
+    updateWebProcessPid(app, app->page() ? app->page()->getWebProcessPID() : 0);
+}
+
+WebAppBase* WebAppRegistry::findById(const QString& appId) const
+{
+    WebAppBase* app = m_appsById.value(appId);
+    if (!app || app->page())
+        return app;
+
+    // The earliest instance has no page; take the next one that has
+    for (WebAppBase* other : m_apps) {
+        if (other != app && other->appId() == appId && other->page())
+            return other;
+    }
+    return nullptr;
+}
+
+WebAppBase* WebAppRegistry::findByInstanceId(const QString& instanceId) const
+{
+    WebAppBase* app = m_appsByInstanceId.value(instanceId);
+    return app && app->page() ? app : nullptr;
+}
+
+WebAppRegistry::PidView WebAppRegistry::findByWebProcessPid(uint32_t pid) const
+{
+    auto range = m_appsByPid.equal_range(pid);
+    return PidView(range.first, range.second);
+}
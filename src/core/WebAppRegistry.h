@@ -0,0 +1,87 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef WEBAPPREGISTRY_H
+#define WEBAPPREGISTRY_H
+
+#include <list>
+#include <stdint.h>
+
+#include <QHash>
+#include <QMultiHash>
+#include <QString>
+
+class WebAppBase;
+
+/**
+ * Running web apps in launch order, indexed by app id, instance id
+ * and web process id.
+ *
+ * Iteration goes over the registry itself (or a View of the pid index),
+ * nothing is copied.
+ */
+class WebAppRegistry {
+public:
+    typedef std::list<WebAppBase*> AppList;
+    typedef AppList::const_iterator const_iterator;
+
+    template <typename Iterator>
+    class View {
+    public:
+        View(Iterator begin, Iterator end)
+            : m_begin(begin)
+            , m_end(end)
+        {
+        }
+
+        Iterator begin() const { return m_begin; }
+        Iterator end() const { return m_end; }
+        bool empty() const { return m_begin == m_end; }
+
+    private:
+        Iterator m_begin;
+        Iterator m_end;
+    };
+
+    typedef View<QMultiHash<uint32_t, WebAppBase*>::const_iterator> PidView;
+
+    void add(WebAppBase* app);
+    void remove(WebAppBase* app);
+    void updateWebProcessPid(WebAppBase* app, uint32_t pid);
+    // Re-reads the web process of |app| from its page
+    void refreshWebProcessPid(WebAppBase* app);
+
+    WebAppBase* findById(const QString& appId) const;
+    WebAppBase* findByInstanceId(const QString& instanceId) const;
+    // Apps last reported to run in the web process |pid|
+    PidView findByWebProcessPid(uint32_t pid) const;
+    // Web process last reported for |app|, 0 if none
+    uint32_t webProcessPid(WebAppBase* app) const { return m_pids.value(app); }
+
+    const_iterator begin() const { return m_apps.begin(); }
+    const_iterator end() const { return m_apps.end(); }
+    size_t size() const { return m_apps.size(); }
+    bool empty() const { return m_apps.empty(); }
+
+private:
+    AppList m_apps;
+    QHash<QString, WebAppBase*> m_appsById;
+    QHash<QString, WebAppBase*> m_appsByInstanceId;
+    QMultiHash<uint32_t, WebAppBase*> m_appsByPid;
+    QHash<WebAppBase*, uint32_t> m_pids;
+};
+
+#endif /* WEBAPPREGISTRY_H */
@@ -18,8 +18,6 @@
 
 #include <QDir>
 #include <QFileInfo>
-#include <QtCore/QJsonDocument>
-#include <QtCore/QJsonObject>
 
 #include "ApplicationDescription.h"
 #include "LogManager.h"
@@ -47,7 +45,7 @@ WebPageBase::WebPageBase()
 {
 }
 
-WebPageBase::WebPageBase(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const QString& params)
+WebPageBase::WebPageBase(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& params)
     : m_appDesc(desc)
     , m_appId(QString::fromStdString(desc->id()))
     , m_suspendAtLoad(false)
@@ -71,10 +69,10 @@ WebPageBase::~WebPageBase()
 
 QString WebPageBase::launchParams() const
 {
-    return m_launchParams;
+    return m_launchParams.toJson();
 }
 
-void WebPageBase::setLaunchParams(const QString& params)
+void WebPageBase::setLaunchParams(const LaunchParams& params)
 {
     m_launchParams = params;
 }
@@ -96,7 +94,7 @@ QString WebPageBase::getIdentifier() const
 
 void WebPageBase::load()
 {
-    LOG_INFO(MSGID_WEBPAGE_LOAD, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "m_launchParams:%s", qPrintable(m_launchParams));
+    LOG_INFO(MSGID_WEBPAGE_LOAD, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "m_launchParams:%s", qPrintable(m_launchParams.toJson()));
     /* this function is main load of WebPage : load default url */
     setupLaunchEvent();
     if (!doDeeplinking(m_launchParams)) {
@@ -128,7 +126,7 @@ void WebPageBase::setupLaunchEvent()
 
 void WebPageBase::sendLocaleChangeEvent(const QString& language)
 {
-    evaluateJavaScript(QStringLiteral(
+    sendEvent(QStringLiteral("webOSLocaleChange"), QStringLiteral(
         "setTimeout(function () {"
         "    var localeEvent=new CustomEvent('webOSLocaleChange');"
         "    document.dispatchEvent(localeEvent);"
@@ -136,12 +134,20 @@ void WebPageBase::sendLocaleChangeEvent(const QString& language)
     ));
 }
 
+void WebPageBase::sendEvent(const QString& type, const QString& jsCode, bool allFrames)
+{
+    if (allFrames)
+        evaluateJavaScriptInAllFrames(jsCode);
+    else
+        evaluateJavaScript(jsCode);
+}
+
 void WebPageBase::cleanResources()
 {
     setCleaningResources(true);
 }
 
-bool WebPageBase::relaunch(const QString& launchParams, const QString& launchingAppId)
+bool WebPageBase::relaunch(const LaunchParams& launchParams, const QString& launchingAppId)
 {
     resumeWebPagePaintingAndJSExecution();
 
@@ -168,7 +174,7 @@ bool WebPageBase::relaunch(const QString& launchParams, const QString& launching
     return true;
 }
 
-bool WebPageBase::doHostedWebAppRelaunch(const QString& launchParams)
+bool WebPageBase::doHostedWebAppRelaunch(const LaunchParams& launchParams)
 {
     /* hosted webapp deeplinking spec
     // legacy case
@@ -183,11 +189,10 @@ bool WebPageBase::doHostedWebAppRelaunch(const QString& launchParams)
     To support backward compatibility, should cover the case not having "handledBy"
     */
     // check deeplinking relaunch condition
-    QJsonObject obj = QJsonDocument::fromJson(launchParams.toUtf8()).object();
     if (url().scheme() ==  "file"
         || m_defaultUrl.scheme() != "file"
-        || obj.isEmpty() /* no launchParams, { }, and this should be check with object().isEmpty()*/
-        || obj.value("contentTarget").isUndefined()
+        || launchParams.isEmpty() /* no launchParams, { }, and this should be check with object().isEmpty()*/
+        || !launchParams.hasContentTarget()
         || (m_appDesc && !m_appDesc->handlesDeeplinking())) {
         LOG_INFO(MSGID_WEBPAGE_RELAUNCH, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()),
             "%s; NOT enough deeplinking condition; return false", __func__);
@@ -199,15 +204,14 @@ bool WebPageBase::doHostedWebAppRelaunch(const QString& launchParams)
     return doDeeplinking(launchParams);
 }
 
-bool WebPageBase::doDeeplinking(const QString& launchParams)
+bool WebPageBase::doDeeplinking(const LaunchParams& launchParams)
 {
-    QJsonObject obj = QJsonDocument::fromJson(launchParams.toUtf8()).object();
-    if (obj.isEmpty() || obj.value("contentTarget").isUndefined())
+    if (launchParams.isEmpty() || !launchParams.hasContentTarget())
         return false;
 
-    std::string handledBy = obj.value("handledBy").isUndefined() ? "default" : obj.value("handledBy").toString().toStdString();
+    std::string handledBy = launchParams.handledBy().toStdString();
     if (handledBy == "platform") {
-        std::string targetUrl = obj.value("contentTarget").toString().toStdString();
+        std::string targetUrl = launchParams.contentTarget().toStdString();
         LOG_INFO(MSGID_DEEPLINKING, 3, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()),
             PMLOGKS("handledBy", handledBy.c_str()),
             "%s; load target URL:%s", __func__, targetUrl.c_str());
@@ -341,6 +345,21 @@ int WebPageBase::maxCustomSuspendDelay()
     return WebAppManager::instance()->getMaxCustomSuspendDelay();
 }
 
+int WebPageBase::learnedSuspendDelay()
+{
+    return WebAppManager::instance()->learnedSuspendDelay(appId());
+}
+
+void WebPageBase::suspendDelayStarted(int delayMs)
+{
+    WebAppManager::instance()->suspendDelayStarted(appId(), delayMs);
+}
+
+void WebPageBase::suspendDelayEnded(bool suspended)
+{
+    WebAppManager::instance()->suspendDelayEnded(appId(), suspended);
+}
+
 QString WebPageBase::telluriumNubPath()
 {
     return getWebAppManagerConfig()->getTelluriumNubPath();
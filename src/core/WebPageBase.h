@@ -23,6 +23,7 @@
 #include <QtCore/QString>
 #include <QtCore/QUrl>
 
+#include "LaunchParams.h"
 #include "ObserverList.h"
 
 #include "webos/webview_base.h"
@@ -53,13 +54,13 @@ public:
     };
 
     WebPageBase();
-    WebPageBase(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const QString& params);
+    WebPageBase(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& params);
     virtual ~WebPageBase();
 
     // WebPageBase
     virtual void init() = 0;
     virtual void* getWebContents() = 0;
-    virtual void setLaunchParams(const QString& params);
+    virtual void setLaunchParams(const LaunchParams& params);
     virtual void notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level) {}
 
     virtual QString getIdentifier() const;
@@ -83,9 +84,12 @@ public:
     virtual void closeVkb() = 0;
     virtual void keyboardVisibilityChanged(bool visible) {}
     virtual void handleDeviceInfoChanged(const QString& deviceInfo) = 0;
-    virtual bool relaunch(const QString& args, const QString& launchingAppId);
+    virtual bool relaunch(const LaunchParams& args, const QString& launchingAppId);
     virtual void evaluateJavaScript(const QString& jsCode) = 0;
     virtual void evaluateJavaScriptInAllFrames(const QString& jsCode, const char* method = "") = 0;
+    // Runs |jsCode| dispatching a DOM event of |type|. A page that is not
+    // running JS may hold the latest script of each type until it resumes.
+    virtual void sendEvent(const QString& type, const QString& jsCode, bool allFrames = false);
     virtual void setForceActivateVtg(bool enabled) = 0;
     virtual uint32_t getWebProcessProxyID() = 0;
     virtual uint32_t getWebProcessPID() const = 0;
@@ -100,6 +104,10 @@ public:
     virtual void suspendWebPageMedia() = 0;
     virtual void resumeWebPageMedia() = 0;
     virtual void resumeWebPagePaintingAndJSExecution() = 0;
+    // Suspends DOM now if a hidden page is still waiting out its suspend delay
+    virtual bool expireDOMSuspendDelay() { return false; }
+    // Falls back to the base suspend delay if a learned one is pending
+    virtual void expireLearnedSuspendDelay() {}
     virtual bool isRegisteredCloseCallback() { return false; }
     virtual void executeCloseCallback(bool forced) {}
     virtual void reloadExtensionData() {}
@@ -119,11 +127,13 @@ public:
     QString launchParams() const;
     void setApplicationDescription(std::shared_ptr<ApplicationDescription> desc);
     void load();
+    void showErrorPage(int errorCode) { loadErrorPage(errorCode); }
     void setEnableBackgroundRun(bool enable) { m_enableBackgroundRun = enable; }
+    bool isEnableBackgroundRun() const { return m_enableBackgroundRun; }
     void sendLocaleChangeEvent(const QString& language);
     void setCleaningResources(bool cleaningResources) { m_cleaningResources = cleaningResources; }
     bool cleaningResources() const { return m_cleaningResources; }
-    bool doHostedWebAppRelaunch(const QString& launchParams);
+    bool doHostedWebAppRelaunch(const LaunchParams& launchParams);
     void sendRelaunchEvent();
     void setAppId(const QString& appId) { m_appId = appId; }
     const QString& appId() const { return m_appId; }
@@ -144,6 +154,12 @@ public:
     virtual void activateRendererCompositor() { }
     virtual void deactivateRendererCompositor() { }
 
+    // Drops the web view and what its renderer holds, keeping the URL and
+    // launch parameters to load the page again with restoreDiscarded()
+    virtual bool discard() { return false; }
+    virtual bool isDiscarded() const { return false; }
+    virtual void restoreDiscarded() {}
+
 Q_SIGNALS:
     void webPageUrlChanged();
     void webPageLoadFinished();
@@ -170,7 +186,7 @@ protected:
     virtual void loadErrorPage(int errorCode) = 0;
     virtual void recreateWebView() = 0;
     virtual void setVisible(bool visible) {}
-    virtual bool doDeeplinking(const QString& launchParams);
+    virtual bool doDeeplinking(const LaunchParams& launchParams);
 
     void handleLoadStarted();
     void handleLoadFinished();
@@ -184,6 +200,9 @@ protected:
     bool processCrashed();
 
     virtual int maxCustomSuspendDelay();
+    int learnedSuspendDelay();
+    void suspendDelayStarted(int delayMs);
+    void suspendDelayEnded(bool suspended);
     QString telluriumNubPath();
 
     void applyPolicyForUrlResponse(bool isMainFrame, const QString& url, int statusCode);
@@ -200,7 +219,7 @@ protected:
     bool m_didErrorPageLoadedFromNetErrorHelper;
     bool m_enableBackgroundRun;
     QUrl m_defaultUrl;
-    QString m_launchParams;
+    LaunchParams m_launchParams;
     QString m_loadErrorPolicy;
     ObserverList<WebPageObserver> m_observers;
 
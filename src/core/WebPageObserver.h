@@ -23,6 +23,7 @@ class WebPageObserver {
 public:
     virtual void titleChanged() {}
     virtual void firstFrameVisuallyCommitted() {}
+    virtual void navigationStarted() {}
     virtual void navigationHistoryChanged() {}
 
 protected:
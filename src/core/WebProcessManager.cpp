@@ -16,7 +16,11 @@
 
 #include "WebProcessManager.h"
 
+#include <errno.h>
 #include <signal.h>
+
+#include <algorithm>
+
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -31,10 +35,27 @@
 
 #include <glib.h>
 
+// How often pending kills are checked for idleness
+static const int kPendingKillCheckMs = 1000;
+
 WebProcessManager::WebProcessManager()
     : m_maximumNumberOfProcesses(1)
+    , m_killRequests(0)
+    , m_kills(0)
+    , m_cancelledKills(0)
+    , m_reclaimedKB(0)
+    , m_killLatencyTotal(0)
+    , m_killLatencyMax(0)
 {
     readWebProcessPolicy();
+
+    int samplingInterval = WebAppManager::instance()->config()->getProcessSamplingInterval();
+    if (samplingInterval > 0)
+        m_processSampler.reset(new ProcessSampler(samplingInterval));
+}
+
+WebProcessManager::~WebProcessManager()
+{
 }
 
 std::list<const WebAppBase*> WebProcessManager::runningApps()
@@ -52,6 +73,11 @@ WebAppBase* WebProcessManager::findAppById(const QString& appId)
     return WebAppManager::instance()->findAppById(appId);
 }
 
+const WebAppRegistry& WebProcessManager::appRegistry()
+{
+    return WebAppManager::instance()->appRegistry();
+}
+
 bool WebProcessManager::webProcessInfoMapReady()
 {
     uint32_t count = 0;
@@ -87,8 +113,27 @@ uint32_t WebProcessManager::getWebProcessProxyID(uint32_t pid) const
     return 0;
 }
 
+std::shared_ptr<const ProcessSnapshot> WebProcessManager::processSnapshot() const
+{
+    return m_processSampler ? m_processSampler->snapshot() : nullptr;
+}
+
+void WebProcessManager::watchWebProcess(uint32_t pid)
+{
+    if (m_processSampler)
+        m_processSampler->watch(pid);
+}
+
 QString WebProcessManager::getWebProcessMemSize(uint32_t pid) const
 {
+    if (m_processSampler) {
+        std::shared_ptr<const ProcessSnapshot> snapshot = m_processSampler->snapshot();
+        if (const ProcessSample* sample = snapshot->latest(pid))
+            return QString::number(sample->rss) + QStringLiteral(" kB");
+        // Not sampled yet, read it here this once
+        m_processSampler->watch(pid);
+    }
+
     QString filePath = QString("/proc/") + QString::number(pid) + QString("/status");
     FILE *fd = fopen(filePath.toStdString().c_str(), "r");
     QString vmrss;
@@ -125,6 +170,9 @@ void WebProcessManager::readWebProcessPolicy()
         return;
     }
 
+    m_processKeyIndex.clear();
+    m_processKeys.clear();
+
     bool createProcessForEachApp = webProcessEnvironment.object().value("createProcessForEachApp").toBool();
     if (createProcessForEachApp)
         m_maximumNumberOfProcesses = UINT_MAX;
@@ -136,12 +184,14 @@ void WebProcessManager::readWebProcessPolicy()
                 QString id = obj.value("id").toString();
 
                 m_webProcessGroupAppIDList.append(id);
+                m_processKeyIndex.addAppIds(id);
                 setWebProcessCacheProperty(obj, id);
             }
             else if (!obj.value("trustLevel").isUndefined()) {
                 QString trustLevel = obj.value("trustLevel").toString();
 
                 m_webProcessGroupTrustLevelList.append(trustLevel);
+                m_processKeyIndex.addTrustLevels(trustLevel);
                 setWebProcessCacheProperty(obj, trustLevel);
             }
         }
@@ -182,48 +232,25 @@ QString WebProcessManager::getProcessKey(const ApplicationDescription* desc) con
     if (!desc)
         return QString();
 
-    QString key;
-    QStringList idList, trustLevelList;
     if (m_maximumNumberOfProcesses == 1)
-        key = QStringLiteral("system");
-    else if (m_maximumNumberOfProcesses == UINT_MAX) {
+        return QStringLiteral("system");
+
+    if (m_maximumNumberOfProcesses == UINT_MAX) {
         if (desc->trustLevel() == "default" || desc->trustLevel() == "trusted")
-            key = QStringLiteral("system");
-        else
-            key = desc->id().c_str();
+            return QStringLiteral("system");
+        return QString::fromStdString(desc->id());
     }
-    else {
-        for (int i = 0; i < m_webProcessGroupAppIDList.size(); i++) {
-            QString appId = m_webProcessGroupAppIDList.at(i);
-            if (appId.contains("*")) {
-                appId.remove(QChar('*'));
-                idList.append(appId.split(","));
-                Q_FOREACH(QString id, idList) {
-                    if (QString::fromUtf8(desc->id().c_str()).startsWith(id))
-                        key = m_webProcessGroupAppIDList.at(i);
-                }
-            } else {
-                idList.append(appId.split(","));
-                Q_FOREACH(QString id, idList) {
-                    if (!id.compare(desc->id().c_str()))
-                        return m_webProcessGroupAppIDList.at(i);
-                }
-            }
-        }
-        if (!key.isEmpty())
-            return key;
-
-        for (int i = 0; i < m_webProcessGroupTrustLevelList.size(); i++) {
-            QString trustLevel = m_webProcessGroupTrustLevelList.at(i);
-            trustLevelList.append(trustLevel.split(","));
-            Q_FOREACH(QString trust, trustLevelList) {
-                if (!trust.compare(desc->trustLevel().c_str())) {
-                    return m_webProcessGroupTrustLevelList.at(i);
-                }
-            }
-        }
+
+    QString appId = QString::fromStdString(desc->id());
+    auto it = m_processKeys.constFind(appId);
+    if (it != m_processKeys.constEnd() && it.value().trustLevel == desc->trustLevel())
+        return it.value().key;
+
+    QString key = m_processKeyIndex.find(appId, QString::fromStdString(desc->trustLevel()));
+    if (key.isEmpty())
         key = QStringLiteral("system");
-    }
+
+    m_processKeys.insert(appId, ProcessKey{desc->trustLevel(), key});
     return key;
 }
 
@@ -242,13 +269,161 @@ void WebProcessManager::killWebProcess(uint32_t pid)
         LOG_ERROR(MSGID_KILL_WEBPROCESS_FAILED, 1, PMLOGKS("ERROR", strerror(errno)), "SystemCall failed");
 }
 
-void WebProcessManager::requestKillWebProcess(uint32_t pid)
+void WebProcessManager::requestKillWebProcess(uint32_t pid, const QString& key)
 {
+    if (!pid || m_pendingKills.contains(pid))
+        return;
+
     for (QMap<QString, WebProcessInfo>::iterator it = m_webProcessInfoMap.begin(); it != m_webProcessInfoMap.end(); it++) {
         if (it.value().webProcessPid == pid) {
-            LOG_INFO(MSGID_KILL_WEBPROCESS_DELAYED, 1, PMLOGKFV("PID", "%u", pid), "");
             it.value().requestKill = true;
-            return;
+            break;
+        }
+    }
+
+    PendingKill pending;
+    pending.key = key;
+    if (pending.key.isEmpty()) {
+        for (const WebAppBase* app : appRegistry().findByWebProcessPid(pid)) {
+            pending.key = getProcessKey(app->getAppDescription());
+            break;
         }
     }
+    pending.requestedAt = g_get_monotonic_time();
+    pending.idleSince = pending.requestedAt;
+    pending.cpuTime = 0;
+    m_pendingKills.insert(pid, pending);
+    m_killRequests++;
+
+    LOG_INFO(MSGID_KILL_WEBPROCESS_DELAYED, 2, PMLOGKFV("PID", "%u", pid), PMLOGKS("KEY", qPrintable(pending.key)), "");
+
+    if (!m_pendingKillTimer.isRunning())
+        m_pendingKillTimer.start(kPendingKillCheckMs, this, &WebProcessManager::checkPendingKills);
+}
+
+void WebProcessManager::cancelKillWebProcess(const ApplicationDescription* desc)
+{
+    if (!desc || m_pendingKills.isEmpty())
+        return;
+
+    // Every app shares the "system" key, only real groups are matched;
+    // WebAppManager cancels by pid once the page has a renderer
+    QString key = getProcessKey(desc);
+    if (key == QStringLiteral("system"))
+        return;
+
+    for (auto it = m_pendingKills.begin(); it != m_pendingKills.end();) {
+        if (it.value().key == key) {
+            LOG_DEBUG("Kill of web process %u cancelled; %s launched", it.key(), desc->id().c_str());
+            it = m_pendingKills.erase(it);
+            m_cancelledKills++;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void WebProcessManager::cancelKillWebProcess(uint32_t pid)
+{
+    if (m_pendingKills.remove(pid))
+        m_cancelledKills++;
+}
+
+bool WebProcessManager::isWebProcessInUse(uint32_t pid, const QString& key)
+{
+    bool grouped = !key.isEmpty() && key != QStringLiteral("system");
+    for (const WebAppBase* app : appRegistry()) {
+        if (!app->page() || app->isClosing())
+            continue;
+        // Any live page keeps its renderer; a group only by its foreground apps
+        if (getWebProcessPID(app) == pid)
+            return true;
+        if (grouped && getProcessKey(app->getAppDescription()) == key
+            && (app->isActivated() || app->keepAlive()))
+            return true;
+    }
+    return false;
+}
+
+void WebProcessManager::checkPendingKills()
+{
+    int gracePeriod = WebAppManager::instance()->config()->getWebProcessKillGracePeriod();
+    int64_t now = g_get_monotonic_time();
+    std::shared_ptr<const ProcessSnapshot> snapshot = processSnapshot();
+
+    for (auto it = m_pendingKills.begin(); it != m_pendingKills.end();) {
+        uint32_t pid = it.key();
+        PendingKill& pending = it.value();
+
+        if (kill(pid, 0) == -1 && errno == ESRCH) {
+            it = m_pendingKills.erase(it);
+            continue;
+        }
+
+        const ProcessSample* sample = snapshot ? snapshot->latest(pid) : nullptr;
+        if (isWebProcessInUse(pid, pending.key)) {
+            pending.idleSince = now;
+        } else if (sample && sample->cpuTime != pending.cpuTime) {
+            // Still running something (e.g. unload handlers)
+            pending.cpuTime = sample->cpuTime;
+            pending.idleSince = now;
+        }
+
+        if (now - pending.idleSince < static_cast<int64_t>(gracePeriod) * 1000) {
+            ++it;
+            continue;
+        }
+
+        uint64_t sizeKB = 0;
+        if (sample)
+            sizeKB = sample->pss ? sample->pss : sample->rss;
+        else
+            sizeKB = getWebProcessMemSize(pid).section(' ', 0, 0).toULongLong();
+
+        int64_t latency = (now - pending.requestedAt) / 1000;
+        killWebProcess(pid);
+
+        m_kills++;
+        m_reclaimedKB += sizeKB;
+        m_killLatencyTotal += latency;
+        m_killLatencyMax = std::max(m_killLatencyMax, latency);
+        LOG_DEBUG("Web process %u reclaimed; %llu kB, %lld ms after the request",
+                  pid, static_cast<unsigned long long>(sizeKB), static_cast<long long>(latency));
+
+        it = m_pendingKills.erase(it);
+    }
+
+    if (m_pendingKills.isEmpty())
+        m_pendingKillTimer.stop();
+}
+
+QJsonObject WebProcessManager::cacheBudget(uint32_t pid)
+{
+    QJsonObject reply;
+    QString key;
+    for (const WebAppBase* app : appRegistry().findByWebProcessPid(pid)) {
+        key = getProcessKey(app->getAppDescription());
+        break;
+    }
+    if (key.isEmpty())
+        return reply;
+
+    WebProcessInfo info = m_webProcessInfoMap.value(key, WebProcessInfo(0, 0));
+    reply["key"] = key;
+    reply["memoryCacheMB"] = static_cast<int>(info.memoryCacheSize);
+    reply["codeCacheMB"] = static_cast<int>(info.codeCacheSize);
+    return reply;
+}
+
+QJsonObject WebProcessManager::reclaimCounters() const
+{
+    QJsonObject counters;
+    counters["requested"] = static_cast<int>(m_killRequests);
+    counters["killed"] = static_cast<int>(m_kills);
+    counters["cancelled"] = static_cast<int>(m_cancelledKills);
+    counters["pending"] = m_pendingKills.size();
+    counters["reclaimedKB"] = static_cast<double>(m_reclaimedKB);
+    counters["averageKillLatencyMs"] = m_kills ? static_cast<double>(m_killLatencyTotal / m_kills) : 0;
+    counters["maxKillLatencyMs"] = static_cast<double>(m_killLatencyMax);
+    return counters;
 }
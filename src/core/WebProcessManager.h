@@ -18,26 +18,47 @@
 #define WEBPROCESSMANAGER_H
 
 #include <list>
+#include <memory>
+#include <string>
 
+#include <QHash>
 #include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QString>
 
+#include "ProcessKeyIndex.h"
+#include "ProcessSampler.h"
+#include "Timer.h"
+
 class ApplicationDescription;
 class WebPageBase;
 class WebAppBase;
+class WebAppRegistry;
 
 class WebProcessManager {
 public:
     WebProcessManager();
-    virtual ~WebProcessManager() {}
+    virtual ~WebProcessManager();
 
     uint32_t getWebProcessProxyID(const ApplicationDescription* desc) const;
     uint32_t getWebProcessProxyID(uint32_t pid) const;
     QString getWebProcessMemSize(uint32_t pid) const; //change name from webProcessSize(uint32_t pid)
+    // Latest samples of the web processes, nullptr if sampling is disabled
+    std::shared_ptr<const ProcessSnapshot> processSnapshot() const;
+    void watchWebProcess(uint32_t pid);
     void killWebProcess(uint32_t pid);
-    void requestKillWebProcess(uint32_t pid);
+    // Kills |pid| once nothing needs it and it has been idle for a while;
+    // |key| is its process key if it is no longer known from its apps
+    void requestKillWebProcess(uint32_t pid, const QString& key = QString());
+    // A launch of |desc|, or an app on |pid|, needs the process again
+    void cancelKillWebProcess(const ApplicationDescription* desc);
+    void cancelKillWebProcess(uint32_t pid);
+    QJsonObject reclaimCounters() const;
+    // Process key of |pid| and the cache sizes configured for it, empty if no
+    // app runs on it. The engine sizes its caches by itself; these are only
+    // what the web process policy asks for.
+    QJsonObject cacheBudget(uint32_t pid);
     bool webProcessInfoMapReady();
     void setWebProcessCacheProperty(QJsonObject object, QString key); //change name from setWebProcessProperty()
     void readWebProcessPolicy(); //chane name from setWebProcessEnvironment()
@@ -49,11 +70,18 @@ public:
     virtual uint32_t getInitialWebViewProxyID() const = 0;
     virtual void clearBrowsingData(const int removeBrowsingDataMask) = 0;
     virtual int maskForBrowsingDataType(const char* type) = 0;
+    // Construct spare web views and windows ahead of launches, if the
+    // platform can
+    virtual void prepareWebViews() {}
+    virtual void prepareWindows() {}
+    // Spare window hits and misses, empty if the platform has no pool
+    virtual QJsonObject windowPoolStats() const { return QJsonObject(); }
 
 protected:
     std::list<const WebAppBase*> runningApps();
     std::list<const WebAppBase*> runningApps(uint32_t pid);
     WebAppBase* findAppById(const QString& appId);
+    const WebAppRegistry& appRegistry();
 
 protected:
     class WebProcessInfo {
@@ -86,6 +114,36 @@ protected:
     uint32_t m_maximumNumberOfProcesses;
     QList<QString> m_webProcessGroupAppIDList;
     QList<QString> m_webProcessGroupTrustLevelList;
+    ProcessKeyIndex m_processKeyIndex;
+    std::unique_ptr<ProcessSampler> m_processSampler;
+
+private:
+    void checkPendingKills();
+    bool isWebProcessInUse(uint32_t pid, const QString& key);
+
+    struct PendingKill {
+        QString key;
+        int64_t requestedAt;
+        int64_t idleSince;
+        uint64_t cpuTime;
+    };
+    QHash<uint32_t, PendingKill> m_pendingKills;
+    RepeatingTimer<WebProcessManager> m_pendingKillTimer;
+
+    unsigned m_killRequests;
+    unsigned m_kills;
+    unsigned m_cancelledKills;
+    uint64_t m_reclaimedKB;
+    int64_t m_killLatencyTotal;
+    int64_t m_killLatencyMax;
+
+    // Keys already looked up, by app id; the trust level is kept to
+    // notice a change of it
+    struct ProcessKey {
+        std::string trustLevel;
+        QString key;
+    };
+    mutable QHash<QString, ProcessKey> m_processKeys;
 };
 
 #endif /* WEBPROCESSMANAGER_H */
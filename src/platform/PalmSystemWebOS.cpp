@@ -17,6 +17,7 @@
 #include "PalmSystemWebOS.h"
 
 #include "ApplicationDescription.h"
+#include "LaunchParams.h"
 #include "LogManager.h"
 #include "WebAppBase.h"
 #include "WebAppWayland.h"
@@ -32,16 +33,9 @@ PalmSystemWebOS::PalmSystemWebOS(WebAppBase* app)
 {
 }
 
-void PalmSystemWebOS::setLaunchParams(const QString& params)
+void PalmSystemWebOS::setLaunchParams(const LaunchParams& params)
 {
-    QString p = params;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(QByteArray(params.toStdString().c_str()));
-    QJsonObject jsonObject = jsonDoc.object();
-
-    if (jsonDoc.isEmpty() || jsonObject.isEmpty())
-        p = QString();
-
-    m_launchParams = p;
+    m_launchParams = params.isEmpty() ? QString() : params.toJson();
 }
 
 bool PalmSystemWebOS::isActivated() const
@@ -112,7 +106,7 @@ void PalmSystemWebOS::setGroupClientEnvironment(GroupClientCallKey callKey, cons
 {
     ApplicationDescription* appDesc = m_app ? m_app->getAppDescription() : 0;
     if (appDesc) {
-        ApplicationDescription::WindowGroupInfo groupInfo = appDesc->getWindowGroupInfo();
+        const ApplicationDescription::WindowGroupInfo& groupInfo = appDesc->getWindowGroupInfo();
         if (!groupInfo.name.isEmpty() && !groupInfo.isOwner) {
             QJsonDocument jsonDoc = QJsonDocument::fromJson(params);
             switch (callKey) {
@@ -162,6 +156,7 @@ bool PalmSystemWebOS::cursorVisibility()
 
 void PalmSystemWebOS::updateLaunchParams(const QString& launchParams)
 {
-    m_app->page()->setLaunchParams(launchParams);
+    // launchParams set by the app itself arrive as a string and are parsed here
+    m_app->page()->setLaunchParams(LaunchParams::fromJsonString(launchParams));
 }
 
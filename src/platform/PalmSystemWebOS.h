@@ -20,6 +20,7 @@
 #include "PalmSystemBase.h"
 #include <PmLogLib.h>
 
+class LaunchParams;
 class WebAppBase;
 class WebAppWayland;
 
@@ -29,7 +30,7 @@ public:
 
     virtual void setCountry() {}
     virtual void setFolderPath(const QString& params) {}
-    virtual void setLaunchParams(const QString& params);
+    virtual void setLaunchParams(const LaunchParams& params);
 
 protected:
     enum GroupClientCallKey {
@@ -96,6 +96,7 @@ static webos::WebAppWindowBase::LocationHint getLocationHintFromString(const std
 
 void WebAppWayland::init(int width, int height)
 {
+    m_launchTimeoutTimer.setSlack(1000);
     if (!m_appWindow)
         m_appWindow = WebAppWaylandWindow::take();
     if (!(width && height)) {
@@ -142,23 +143,27 @@ void WebAppWayland::startLaunchTimer()
 
 void WebAppWayland::onDelegateWindowFrameSwapped()
 {
-    if(m_elapsedLaunchTimer.isRunning()) {
+    if (!m_elapsedLaunchTimer.isRunning() && !isLaunchTimelineRunning())
+        return;
+
+    if (m_elapsedLaunchTimer.isRunning())
         m_lastSwappedTime = m_elapsedLaunchTimer.elapsed_ms();
+    markLaunchPhase(LaunchTimeline::LastFrameSwapped);
 
-        m_launchTimeoutTimer.stop();
-        m_launchTimeoutTimer.start(kLaunchFinishAssureTimeoutMs,
-                                   this,
-                                   &WebAppWayland::onLaunchTimeout);
-    }
+    m_launchTimeoutTimer.stop();
+    m_launchTimeoutTimer.start(kLaunchFinishAssureTimeoutMs,
+                               this,
+                               &WebAppWayland::onLaunchTimeout);
 }
 
 void WebAppWayland::onLaunchTimeout()
 {
+    m_launchTimeoutTimer.stop();
     if(m_elapsedLaunchTimer.isRunning()) {
-        m_launchTimeoutTimer.stop();
         m_elapsedLaunchTimer.stop();
         LOG_DEBUG("APP_LAUNCHTIME_CHECK_ALL_FRAMES_DONE [appId:%s time:%d]", qPrintable(appId()), m_lastSwappedTime);
     }
+    finishLaunchTimeline();
 }
 
 void WebAppWayland::forwardWebOSEvent(WebOSEvent* event) const
@@ -277,6 +282,8 @@ void WebAppWayland::onStageActivated()
 
 void WebAppWayland::onStageDeactivated()
 {
+    updateLastForegroundTime();
+    WebAppManager::instance()->appBackgrounded(this);
     page()->suspendWebPageMedia();
     unfocus();
     page()->setVisibilityState(WebPageBase::WebPageVisibilityState::WebPageVisibilityStateHidden);
@@ -319,23 +326,23 @@ void WebAppWayland::setupWindowGroup(ApplicationDescription* desc)
     if (!desc)
         return;
 
-    ApplicationDescription::WindowGroupInfo groupInfo = desc->getWindowGroupInfo();
+    const ApplicationDescription::WindowGroupInfo& groupInfo = desc->getWindowGroupInfo();
     if (groupInfo.name.isEmpty())
         return;
 
     if (groupInfo.isOwner) {
-        ApplicationDescription::WindowOwnerInfo ownerInfo = desc->getWindowOwnerInfo();
+        const ApplicationDescription::WindowOwnerInfo& ownerInfo = desc->getWindowOwnerInfo();
         webos::WindowGroupConfiguration config(groupInfo.name.toStdString());
         config.SetIsAnonymous(ownerInfo.allowAnonymous);
-        QMap<QString, int>::iterator iter = ownerInfo.layers.begin();
-        while (iter != ownerInfo.layers.end()){
+        QMap<QString, int>::const_iterator iter = ownerInfo.layers.constBegin();
+        while (iter != ownerInfo.layers.constEnd()){
           config.AddLayer(webos::WindowGroupLayerConfiguration(iter.key().toStdString(), iter.value()));
           iter++;
         }
         m_appWindow->CreateWindowGroup(config);
         LOG_INFO(MSGID_CREATE_SURFACEGROUP, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", page()->getWebProcessPID()), "");
     } else {
-        ApplicationDescription::WindowClientInfo clientInfo = desc->getWindowClientInfo();
+        const ApplicationDescription::WindowClientInfo& clientInfo = desc->getWindowClientInfo();
         m_appWindow->AttachToWindowGroup(groupInfo.name.toStdString(), clientInfo.layer.toStdString());
         LOG_INFO(MSGID_ATTACH_SURFACEGROUP, 3, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKS("OWNER_ID", qPrintable(groupInfo.name)), PMLOGKFV("PID", "%d", page()->getWebProcessPID()), "");
     }
@@ -462,7 +469,7 @@ void WebAppWayland::focusLayer()
     m_appWindow->FocusWindowGroupLayer();
     ApplicationDescription * desc = getAppDescription();
     if (desc) {
-        ApplicationDescription::WindowClientInfo clientInfo = desc->getWindowClientInfo();
+        const ApplicationDescription::WindowClientInfo& clientInfo = desc->getWindowClientInfo();
         LOG_DEBUG("FocusLayer(layer:%s) [%s]",qPrintable(clientInfo.layer) ,qPrintable(appId()));
     }
 }
@@ -549,6 +556,9 @@ void WebAppWayland::goBackground()
 
 void WebAppWayland::webPageLoadFinishedSlot()
 {
+    if (preloadState() != NONE_PRELOAD)
+        WebAppManager::instance()->recordPreloadMemory(this);
+
     if (getHiddenWindow())
         return;
     if(needReload()) {
@@ -633,6 +643,7 @@ void WebAppWayland::titleChanged()
 
 void WebAppWayland::firstFrameVisuallyCommitted()
 {
+    markLaunchPhase(LaunchTimeline::VisuallyCommitted);
     LOG_INFO(MSGID_WAM_DEBUG, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", page()->getWebProcessPID()), "firstFrameVisuallyCommitted");
     // if m_preloadState != NONE_PRELOAD, then we must ignore the first frame commit
     // if getHiddenWindow() == true, then we have specifically requested that the window is to be hidden,
@@ -663,6 +674,7 @@ void WebAppWayland::navigationHistoryChanged()
 
 void WebAppWayland::webViewRecreatedSlot()
 {
+    WebAppManager::instance()->pageRecreated(this);
     m_appWindow->attachWebContents(page()->getWebContents());
     m_appWindow->RecreatedWebContents();
     page()->setPageProperties();
@@ -671,8 +683,21 @@ void WebAppWayland::webViewRecreatedSlot()
     focus();
 }
 
+bool WebAppWayland::discardPage()
+{
+    if (!WebAppBase::discardPage())
+        return false;
+
+    // Bind the window to the web view standing in for the discarded one
+    m_appWindow->attachWebContents(page()->getWebContents());
+    m_appWindow->RecreatedWebContents();
+    page()->setPageProperties();
+    return true;
+}
+
 void WebAppWayland::didSwapPageCompositorFrame()
 {
+    finishRestore();
     if (m_appWindow)
         m_appWindow->didSwapPageCompositorFrame();
 }
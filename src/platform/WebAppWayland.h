@@ -92,6 +92,7 @@ public:
     void deleteSurfaceGroup() override;
     void keyboardVisibilityChanged(bool visible, int height) override;
     void doClose() override;
+    bool discardPage() override;
 
     // WebAppWayland
     virtual bool isKeyboardVisible() override;
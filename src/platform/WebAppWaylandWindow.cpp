@@ -18,37 +18,19 @@
 #include "LogManager.h"
 #include "WebAppWayland.h"
 #include "WebAppWaylandWindow.h"
-
-WebAppWaylandWindow* WebAppWaylandWindow::s_instance = nullptr;
+#include "WebAppWaylandWindowPool.h"
 
 WebAppWaylandWindow* WebAppWaylandWindow::take()
 {
-    WebAppWaylandWindow* window;
-
-    if (!s_instance) {
-        s_instance = new WebAppWaylandWindow();
-        if (!s_instance) {
-            LOG_CRITICAL(MSGID_TAKE_FAIL, 0, "Failed to take WebAppWaylandWindow");
-            return NULL;
-        }
-    }
-
-    window = s_instance;
-    s_instance = NULL;
+    WebAppWaylandWindow* window = WebAppWaylandWindowPool::instance()->take();
+    if (!window)
+        LOG_CRITICAL(MSGID_TAKE_FAIL, 0, "Failed to take WebAppWaylandWindow");
     return window;
 }
 
 void WebAppWaylandWindow::prepare()
 {
-    if (s_instance)
-        return;
-
-    // TODO: Need to make sure preparing window is helpful
-    WebAppWaylandWindow* window = createWindow();
-    if (!window)
-        return;
-
-    s_instance = window;
+    WebAppWaylandWindowPool::instance()->prepare();
 }
 
 WebAppWaylandWindow* WebAppWaylandWindow::createWindow() {
@@ -165,8 +147,7 @@ bool WebAppWaylandWindow::event(WebOSEvent* event)
             m_webApp->stateAboutToChange(GetWindowHostStateAboutToChange());
             return true;
         case WebOSEvent::Swap:
-            if (m_webApp->isCheckLaunchTimeEnabled())
-                m_webApp->onDelegateWindowFrameSwapped();
+            m_webApp->onDelegateWindowFrameSwapped();
             break;
         case WebOSEvent::KeyPress:
             break;
@@ -194,6 +175,7 @@ bool WebAppWaylandWindow::event(WebOSEvent* event)
             m_webApp->sendWebOSMouseEvent("Leave");
             break;
         case WebOSEvent::FocusIn:
+            m_webApp->markLaunchPhase(LaunchTimeline::FirstFocusIn);
             m_webApp->focus();
             LOG_INFO_WITH_CLOCK(MSGID_WINDOW_FOCUSIN, 3,
                     PMLOGKS("PerfType", "AppLaunch"),
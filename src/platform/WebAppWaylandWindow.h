@@ -19,6 +19,7 @@
 
 #include "webos/webapp_window_base.h"
 
+
 class WebAppWayland;
 
 class WebAppWaylandWindow : public webos::WebAppWindowBase {
@@ -65,7 +66,7 @@ private:
     void logEventDebugging(WebOSEvent* event);
 
 private:
-    static WebAppWaylandWindow* s_instance;
+    friend class WebAppWaylandWindowPool;
 
     bool m_cursorEnabled;
 
@@ -0,0 +1,85 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "WebAppWaylandWindowPool.h"
+
+#include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+#include "WebAppWaylandWindow.h"
+
+// Wait for the launch that took a window to settle before creating another
+static const int kFillDelayMs = 2000;
+static const int kFillMinCpuIdle = 700; // 70.0%
+
+WebAppWaylandWindowPool* WebAppWaylandWindowPool::instance()
+{
+    // not a leak -- static variable initializations are only ever done once
+    static WebAppWaylandWindowPool* sInstance = new WebAppWaylandWindowPool();
+    return sInstance;
+}
+
+WebAppWaylandWindowPool::WebAppWaylandWindowPool()
+    : m_depth(static_cast<size_t>(WebAppManager::instance()->config()->getWindowPoolSize()))
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+WebAppWaylandWindow* WebAppWaylandWindowPool::take()
+{
+    WebAppWaylandWindow* window = nullptr;
+
+    if (!m_windows.empty()) {
+        window = m_windows.front();
+        m_windows.pop_front();
+        m_hits++;
+    } else {
+        window = new WebAppWaylandWindow();
+        m_misses++;
+    }
+
+    LOG_DEBUG("WebAppWaylandWindowPool: take; hits: %u, misses: %u", m_hits, m_misses);
+    scheduleFill();
+    return window;
+}
+
+void WebAppWaylandWindowPool::prepare()
+{
+    scheduleFill();
+}
+
+void WebAppWaylandWindowPool::scheduleFill()
+{
+    m_fillTimer.start(kFillDelayMs, kFillMinCpuIdle, this, &WebAppWaylandWindowPool::fill);
+}
+
+void WebAppWaylandWindowPool::fill()
+{
+    if (m_windows.size() >= m_depth)
+        return;
+
+    WebAppWaylandWindow* window = WebAppWaylandWindow::createWindow();
+    if (!window)
+        return;
+
+    m_windows.push_back(window);
+    LOG_DEBUG("WebAppWaylandWindowPool: spare window prepared (%zu/%zu)", m_windows.size(), m_depth);
+
+    // Deeper spares wait for the next idle period
+    if (m_windows.size() < m_depth)
+        scheduleFill();
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef WEBAPPWAYLANDWINDOWPOOL_H
+#define WEBAPPWAYLANDWINDOWPOOL_H
+
+#include <list>
+
+#include "IdleTimer.h"
+
+class WebAppWaylandWindow;
+
+/**
+ * Spare WebAppWaylandWindows, created ahead of launches.
+ *
+ * Spares are kept up to the configured depth. They are not bound to a
+ * display, so one list serves every display affinity; the app binds the
+ * window it takes. Spares are created one at a time while WAM is idle,
+ * and the pool is refilled after every take.
+ */
+class WebAppWaylandWindowPool {
+public:
+    static WebAppWaylandWindowPool* instance();
+
+    // Spare window if there is one, a new one otherwise
+    WebAppWaylandWindow* take();
+    // Starts filling spares
+    void prepare();
+
+    size_t size() const { return m_windows.size(); }
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    WebAppWaylandWindowPool();
+
+    void scheduleFill();
+    void fill();
+
+    std::list<WebAppWaylandWindow*> m_windows;
+    size_t m_depth;
+    unsigned m_hits;
+    unsigned m_misses;
+    IdleTimer<WebAppWaylandWindowPool> m_fillTimer;
+};
+
+#endif /* WEBAPPWAYLANDWINDOWPOOL_H */
@@ -23,9 +23,13 @@
 #include "WebPageBlink.h"
 #include "WebAppBase.h"
 #include "WebAppManagerUtils.h"
+#include "WebAppRegistry.h"
 #include "LogManager.h"
 #include "BlinkWebView.h"
+#include "BlinkWebViewPool.h"
 #include "BlinkWebViewProfileHelper.h"
+#include "WebAppWaylandWindow.h"
+#include "WebAppWaylandWindowPool.h"
 #include "WebProcessManager.h"
 
 uint32_t BlinkWebProcessManager::getWebProcessPID(const WebAppBase* app) const
@@ -37,33 +41,41 @@ QJsonObject BlinkWebProcessManager::getWebProcessProfiling()
 {
     QJsonObject reply;
     QJsonArray processArray;
-    QJsonObject processObject;
     uint32_t pid;
     QList<uint32_t> processIdList;
 
-    QMap<uint32_t, QString> runningAppList;
-    std::list<const WebAppBase*> running = runningApps();
-    for (std::list<const WebAppBase*>::iterator it = running.begin(); it != running.end(); ++it) {
-        WebAppBase* app = findAppById((*it)->appId());
+    QMap<uint32_t, const WebAppBase*> runningAppList;
+    for (const WebAppBase* app : appRegistry()) {
         pid = getWebProcessPID(app);
         if (!processIdList.contains(pid))
             processIdList.append(pid);
 
-        runningAppList.insertMulti(pid, app->appId());
+        runningAppList.insertMulti(pid, app);
     }
 
+    std::shared_ptr<const ProcessSnapshot> snapshot = processSnapshot();
     for (int id = 0; id < processIdList.size(); id++) {
+        QJsonObject processObject;
         QJsonObject appObject;
         QJsonArray appArray;
         pid = processIdList.at(id);
 
         processObject["pid"] = QString::number(pid);
         processObject["webProcessSize"] = getWebProcessMemSize(pid);
+        if (const ProcessSample* sample = snapshot ? snapshot->latest(pid) : nullptr) {
+            processObject["pss"] = QString::number(sample->pss) + QStringLiteral(" kB");
+            processObject["uss"] = QString::number(sample->uss) + QStringLiteral(" kB");
+            processObject["swap"] = QString::number(sample->swap) + QStringLiteral(" kB");
+        }
+        QJsonObject cacheBudgetObject = cacheBudget(pid);
+        if (!cacheBudgetObject.isEmpty())
+            processObject["cacheBudget"] = cacheBudgetObject;
         //starfish-surface is note used on Blink
         processObject["tileSize"] = 0;
-        QList<QString> processApp = runningAppList.values(pid);
+        QList<const WebAppBase*> processApp = runningAppList.values(pid);
         for (int app = 0; app < processApp.size(); app++) {
-            appObject["id"] = processApp.at(app);
+            appObject["id"] = processApp.at(app)->appId();
+            appObject["preferencePushes"] = static_cast<int>(static_cast<WebPageBlink*>(processApp.at(app)->page())->preferencePushes());
             appArray.append(appObject);
         }
         processObject["runningApps"] = appArray;
@@ -71,15 +83,26 @@ QJsonObject BlinkWebProcessManager::getWebProcessProfiling()
     }
 
     reply["WebProcesses"] = processArray;
+    reply["reclaim"] = reclaimCounters();
+    reply["extensionData"] = WebPageBlink::extensionDataStats();
+    reply["deferredEvents"] = WebPageBlink::deferredEventStats();
+    reply["preferences"] = WebPageBlink::preferenceStats();
+
+    BlinkWebViewPool* pool = BlinkWebViewPool::instance();
+    QJsonObject poolObject;
+    poolObject["spare"] = static_cast<int>(pool->size());
+    poolObject["hits"] = static_cast<int>(pool->hits());
+    poolObject["misses"] = static_cast<int>(pool->misses());
+    reply["webViewPool"] = poolObject;
     reply["returnValue"] = true;
     return reply;
 }
 
 void BlinkWebProcessManager::deleteStorageData(const QString& identifier)
 {
-    std::list<const WebAppBase*> runningAppList = runningApps();
-    if (!runningAppList.empty()) {
-        runningAppList.front()->page()->deleteWebStorages(identifier);
+    const WebAppRegistry& apps = appRegistry();
+    if (!apps.empty()) {
+        (*apps.begin())->page()->deleteWebStorages(identifier);
         return;
     }
 
@@ -104,3 +127,21 @@ int BlinkWebProcessManager::maskForBrowsingDataType(const char* type)
 {
     return BlinkWebViewProfileHelper::maskForBrowsingDataType(type);
 }
+
+void BlinkWebProcessManager::prepareWebViews()
+{
+    BlinkWebViewPool::instance()->prepare();
+}
+
+void BlinkWebProcessManager::prepareWindows()
+{
+    WebAppWaylandWindow::prepare();
+}
+
+QJsonObject BlinkWebProcessManager::windowPoolStats() const
+{
+    QJsonObject windowPool;
+    windowPool["hits"] = static_cast<int>(WebAppWaylandWindowPool::instance()->hits());
+    windowPool["misses"] = static_cast<int>(WebAppWaylandWindowPool::instance()->misses());
+    return windowPool;
+}
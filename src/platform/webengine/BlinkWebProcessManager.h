@@ -31,6 +31,9 @@ public:
     uint32_t getInitialWebViewProxyID() const override;
     void clearBrowsingData(const int removeBrowsingDataMask) override;
     int maskForBrowsingDataType(const char* type) override;
+    void prepareWebViews() override;
+    void prepareWindows() override;
+    QJsonObject windowPoolStats() const override;
 };
 
 #endif /* BLINKEBPROCESSMANAGER_H */
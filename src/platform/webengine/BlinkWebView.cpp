@@ -18,6 +18,8 @@
 #include "WebPageBlinkDelegate.h"
 
 #include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
 #include <QStringList>
 
 BlinkWebView::BlinkWebView(bool doInitialize)
@@ -25,9 +27,43 @@ BlinkWebView::BlinkWebView(bool doInitialize)
     , m_delegate(NULL)
     , m_progress(0)
     , m_userScriptExecuted(false)
+    , m_defaultSettingsApplied(false)
 {
 }
 
+void BlinkWebView::applyDefaultSettings()
+{
+    if (m_defaultSettingsApplied)
+        return;
+
+    m_defaultSettingsApplied = true;
+    SetUserAgent(DefaultUserAgent() + " " + WebAppManager::instance()->config()->getName());
+
+    if(!qgetenv("PRIVILEGED_PLUGIN_PATH").isEmpty()) {
+        QString privileged_plugin_path = QLatin1String(qgetenv("PRIVILEGED_PLUGIN_PATH"));
+        AddAvailablePluginDir(privileged_plugin_path.toStdString());
+    }
+
+    SetAllowFakeBoldText(false);
+
+    // FIXME: It should be permitted for backward compatibility for a limited list of legacy applications only.
+    SetAllowRunningInsecureContent(true);
+    SetAllowScriptsToCloseWindows(true);
+    SetAllowUniversalAccessFromFileUrls(true);
+    SetSuppressesIncrementalRendering(true);
+    SetDisallowScrollbarsInMainFrame(true);
+    SetDisallowScrollingInMainFrame(true);
+    SetJavascriptCanOpenWindows(true);
+    SetSupportsMultipleWindows(false);
+    SetCSSNavigationEnabled(true);
+    SetV8DateUseSystemLocaloffset(false);
+    SetLocalStorageEnabled(true);
+    SetShouldSuppressDialogs(true);
+
+    AddUserStyleSheet("body { -webkit-user-select: none; } :focus { outline: none }");
+    SetBackgroundColor(29, 29, 29, 0xFF);
+}
+
 void BlinkWebView::addUserScript(const std::string& script)
 {
     m_userScripts.push_back(script);
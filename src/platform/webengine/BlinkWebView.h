@@ -35,6 +35,9 @@ public:
     void addUserScript(const std::string& script);
     void clearUserScripts();
     void executeUserScripts();
+    // Settings that are the same for every app; applied once, by
+    // BlinkWebViewPool for spare views or by WebPageBlink::init()
+    void applyDefaultSettings();
     void setDelegate(WebPageBlinkDelegate* delegate);
     WebPageBlinkDelegate* delegate() { return m_delegate; }
     int progress() { return m_progress; }
@@ -75,6 +78,7 @@ private:
     int m_progress;
 
     bool m_userScriptExecuted;
+    bool m_defaultSettingsApplied;
     std::vector<std::string> m_userScripts;
 };
 
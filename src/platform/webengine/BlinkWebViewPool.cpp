@@ -0,0 +1,101 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BlinkWebViewPool.h"
+
+#include "BlinkWebView.h"
+#include "LogManager.h"
+#include "WebAppManager.h"
+#include "WebAppManagerConfig.h"
+
+// Constructing a view sets up a WebContents, the heaviest of the spares
+static const int kFillDelayMs = 3000;
+static const int kFillMinCpuIdle = 700; // 70.0%
+
+BlinkWebViewPool* BlinkWebViewPool::instance()
+{
+    // not a leak -- static variable initializations are only ever done once
+    static BlinkWebViewPool* sInstance = new BlinkWebViewPool();
+    return sInstance;
+}
+
+BlinkWebViewPool::BlinkWebViewPool()
+    : m_capacity(static_cast<size_t>(WebAppManager::instance()->config()->getWebViewPoolSize()))
+    , m_prepared(false)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+BlinkWebViewPool::~BlinkWebViewPool()
+{
+    clear();
+}
+
+BlinkWebView* BlinkWebViewPool::take()
+{
+    BlinkWebView* view;
+    if (!m_views.empty()) {
+        view = m_views.front();
+        m_views.pop_front();
+        m_hits++;
+    } else {
+        view = new BlinkWebView();
+        m_misses++;
+    }
+
+    scheduleFill();
+    return view;
+}
+
+void BlinkWebViewPool::prepare()
+{
+    if (m_prepared)
+        return;
+
+    m_prepared = true;
+    scheduleFill();
+}
+
+void BlinkWebViewPool::clear()
+{
+    m_fillTimer.stop();
+    for (BlinkWebView* view : m_views)
+        delete view;
+    m_views.clear();
+}
+
+void BlinkWebViewPool::scheduleFill()
+{
+    if (!m_prepared || m_views.size() >= m_capacity)
+        return;
+
+    m_fillTimer.start(kFillDelayMs, kFillMinCpuIdle, this, &BlinkWebViewPool::fill);
+}
+
+void BlinkWebViewPool::fill()
+{
+    if (m_views.size() >= m_capacity)
+        return;
+
+    BlinkWebView* view = new BlinkWebView();
+    view->applyDefaultSettings();
+    m_views.push_back(view);
+    LOG_DEBUG("BlinkWebViewPool: spare view prepared (%zu/%zu)", m_views.size(), m_capacity);
+
+    // The next spare waits for another idle period of its own
+    scheduleFill();
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BLINKWEBVIEWPOOL_H
+#define BLINKWEBVIEWPOOL_H
+
+#include <list>
+
+#include "IdleTimer.h"
+
+class BlinkWebView;
+
+/**
+ * Spare BlinkWebViews, constructed ahead of launches.
+ *
+ * Constructing a view sets up its WebContents and, like the default
+ * settings applied to it, does not depend on the app, so it is done while
+ * WAM is idle. WebPageBlink::init() takes a spare view and only has to
+ * initialize it for the app being launched.
+ * The pool is filled once boot is done and refilled after each take.
+ */
+class BlinkWebViewPool {
+public:
+    static BlinkWebViewPool* instance();
+
+    // Spare view if there is one, a new one otherwise
+    BlinkWebView* take();
+    // Starts filling the pool up to its configured size
+    void prepare();
+    void clear();
+
+    size_t size() const { return m_views.size(); }
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+private:
+    BlinkWebViewPool();
+    ~BlinkWebViewPool();
+
+    void scheduleFill();
+    void fill();
+
+    std::list<BlinkWebView*> m_views;
+    size_t m_capacity;
+    bool m_prepared;
+    unsigned m_hits;
+    unsigned m_misses;
+    IdleTimer<BlinkWebViewPool> m_fillTimer;
+};
+
+#endif /* BLINKWEBVIEWPOOL_H */
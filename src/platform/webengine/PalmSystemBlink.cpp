@@ -151,7 +151,7 @@ void PalmSystemBlink::setCountry()
     static_cast<WebPageBlink*>(m_app->page())->updateExtensionData(QStringLiteral("country"), country());
 }
 
-void PalmSystemBlink::setLaunchParams(const QString& params)
+void PalmSystemBlink::setLaunchParams(const LaunchParams& params)
 {
     PalmSystemWebOS::setLaunchParams(params);
     static_cast<WebPageBlink*>(m_app->page())->updateExtensionData(QStringLiteral("launchParams"), launchParams());
@@ -27,7 +27,7 @@ public:
 
     // PalmSystemWebOS
     void setCountry() override;
-    void setLaunchParams(const QString& params) override;
+    void setLaunchParams(const LaunchParams& params) override;
 
     virtual void setLocale(const QString& params);
     virtual double devicePixelRatio();
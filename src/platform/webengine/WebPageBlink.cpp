@@ -27,6 +27,8 @@
 #include "ApplicationDescription.h"
 #include "BlinkWebProcessManager.h"
 #include "BlinkWebView.h"
+#include "BlinkWebViewPool.h"
+#include "LaunchTimeline.h"
 #include "LogManager.h"
 #include "PalmSystemBlink.h"
 #include "WebAppManagerConfig.h"
@@ -42,6 +44,13 @@
 
 static const int kExecuteCloseCallbackTimeOutMs = 10000;
 
+static unsigned sExtensionDataUpdates = 0;
+static unsigned sExtensionDataScripts = 0;
+static unsigned sDeferredEvents = 0;
+static unsigned sReplayedEvents = 0;
+static unsigned sPreferenceUpdates = 0;
+static unsigned sPreferencePushes = 0;
+
 QString getHostname(const std::string& url)
 {
   // Convert given url to QURL and
@@ -76,20 +85,27 @@ public:
 };
 
 
-WebPageBlink::WebPageBlink(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const QString& params)
+WebPageBlink::WebPageBlink(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& params)
     : WebPageBase(url, desc, params)
     , d(new WebPageBlinkPrivate(this))
     , m_isPaused(false)
     , m_isSuspended(false)
     , m_hasCustomPolicyForResponse(false)
     , m_hasBeenShown(false)
+    , m_discarded(false)
     , m_vkbHeight(0)
     , m_vkbWasOverlap(false)
     , m_hasCloseCallback(false)
     , m_trustLevel(QString::fromStdString(desc->trustLevel()))
     , m_customSuspendDOMTime(0)
+    , m_domSuspendStarted(0)
+    , m_suspendDelayLearned(false)
+    , m_preferencesDirty(false)
+    , m_preferencePushes(0)
     , m_observer(nullptr)
 {
+    // A late close callback timeout costs nothing; share its wakeup
+    m_closeCallbackTimer.setSlack(1000);
 }
 
 WebPageBlink::~WebPageBlink()
@@ -105,6 +121,7 @@ void WebPageBlink::init()
 {
     d->pageView = createPageView();
     d->pageView->setDelegate(this);
+    d->pageView->applyDefaultSettings();
     d->pageView->Initialize(m_appDesc->id(),
                             m_appDesc->folderPath(),
                             m_appDesc->trustLevel(),
@@ -114,29 +131,7 @@ void WebPageBlink::init()
     setViewportSize();
 
     d->pageView->SetVisible(false);
-    d->pageView->SetUserAgent(d->pageView->DefaultUserAgent() + " " + getWebAppManagerConfig()->getName());
-
-    if(!qgetenv("PRIVILEGED_PLUGIN_PATH").isEmpty()) {
-        QString privileged_plugin_path = QLatin1String(qgetenv("PRIVILEGED_PLUGIN_PATH"));
-        d->pageView->AddAvailablePluginDir(privileged_plugin_path.toStdString());
-    }
-
-    d->pageView->SetAllowFakeBoldText(false);
-
-    // FIXME: It should be permitted for backward compatibility for a limited list of legacy applications only.
-    d->pageView->SetAllowRunningInsecureContent(true);
-    d->pageView->SetAllowScriptsToCloseWindows(true);
-    d->pageView->SetAllowUniversalAccessFromFileUrls(true);
-    d->pageView->SetSuppressesIncrementalRendering(true);
-    d->pageView->SetDisallowScrollbarsInMainFrame(true);
-    d->pageView->SetDisallowScrollingInMainFrame(true);
     d->pageView->SetDoNotTrack(m_appDesc->doNotTrack());
-    d->pageView->SetJavascriptCanOpenWindows(true);
-    d->pageView->SetSupportsMultipleWindows(false);
-    d->pageView->SetCSSNavigationEnabled(true);
-    d->pageView->SetV8DateUseSystemLocaloffset(false);
-    d->pageView->SetLocalStorageEnabled(true);
-    d->pageView->SetShouldSuppressDialogs(true);
     d->pageView->SetNotifyFMPDirectly(m_appDesc->usePrerendering());
     setDisallowScrolling(m_appDesc->disallowScrollingInMainFrame());
 
@@ -156,9 +151,6 @@ void WebPageBlink::init()
         LOG_DEBUG("[%s] set customSuspendDOMTime : %d ms", qPrintable(appId()), m_customSuspendDOMTime);
     }
 
-    d->pageView->AddUserStyleSheet("body { -webkit-user-select: none; } :focus { outline: none }");
-    d->pageView->SetBackgroundColor(29, 29, 29, 0xFF);
-
     setDefaultFont(defaultFont());
 
     QString language;
@@ -179,7 +171,7 @@ void WebPageBlink::init()
     d->pageView->SetUseUnlimitedMediaPolicy(m_appDesc->useUnlimitedMediaPolicy());
     d->pageView->SetMediaPreferences(m_appDesc->mediaPreferences());
 
-    d->pageView->UpdatePreferences();
+    updatePreferences();
 
     loadExtension();
 }
@@ -225,6 +217,7 @@ void WebPageBlink::setFocus(bool focus)
 
 void WebPageBlink::loadDefaultUrl()
 {
+    commitPreferences();
     d->pageView->LoadUrl(defaultUrl().toString().toStdString());
 }
 
@@ -257,7 +250,7 @@ void WebPageBlink::setPreferredLanguages(const QString& language)
     // just set system language for accept-language for http header, navigator.language, navigator.languages
     // even window.languagechange event too
     d->pageView->SetAcceptLanguages(language.toStdString());
-    d->pageView->UpdatePreferences();
+    updatePreferences();
 #endif
 }
 
@@ -354,6 +347,7 @@ void WebPageBlink::loadErrorPage(int errorCode)
             query.addQueryItem(QStringLiteral("hostname"), m_loadFailedHostname);
             errorUrl.setQuery(query);
             LOG_INFO(MSGID_WAM_DEBUG, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "LoadErrorPage : %s", qPrintable(errorUrl.toString()));
+            commitPreferences();
             d->pageView->LoadUrl(errorUrl.toString().toStdString());
         } else
             LOG_ERROR(MSGID_ERROR_ERROR, 1, PMLOGKS("PATH", qPrintable(errorpage)), "Error loading error page");
@@ -362,15 +356,17 @@ void WebPageBlink::loadErrorPage(int errorCode)
 
 void WebPageBlink::reload()
 {
+    commitPreferences();
     d->pageView->Reload();
 }
 
 void WebPageBlink::loadUrl(const std::string& url)
 {
+    commitPreferences();
     d->pageView->LoadUrl(url);
 }
 
-void WebPageBlink::setLaunchParams(const QString& params)
+void WebPageBlink::setLaunchParams(const LaunchParams& params)
 {
     WebPageBase::setLaunchParams(params);
     if (d->m_palmSystem)
@@ -399,7 +395,7 @@ void WebPageBlink::setAppPreloadHint(bool is_preload)
 void WebPageBlink::setForceActivateVtg(bool enabled)
 {
     d->pageView->SetForceVideoTexture(enabled);
-    d->pageView->UpdatePreferences();
+    updatePreferences();
 }
 
 void WebPageBlink::suspendWebPageAll()
@@ -436,17 +432,21 @@ void WebPageBlink::suspendWebPageAll()
     }
 
     m_isSuspended = true;
+    int delay = m_customSuspendDOMTime ? m_customSuspendDOMTime : learnedSuspendDelay();
     if (shouldStopJSOnSuspend()) {
-        m_domSuspendTimer.start(m_customSuspendDOMTime ? m_customSuspendDOMTime : suspendDelay(),
+        m_domSuspendTimer.start(delay,
                                 this,
                                 &WebPageBlink::suspendWebPagePaintingAndJSExecution);
+        m_domSuspendStarted = LaunchTimeline::now();
+        m_suspendDelayLearned = !m_customSuspendDOMTime && delay > suspendDelay();
+        suspendDelayStarted(delay);
     }
     LOG_INFO(MSGID_SUSPEND_WEBPAGE,
              2,
              PMLOGKS("APP_ID", qPrintable(appId())),
              PMLOGKFV("PID", "%d", getWebProcessPID()),
              "DomSuspendTimer(%dms) Started",
-             m_customSuspendDOMTime ? m_customSuspendDOMTime : suspendDelay());
+             delay);
 }
 
 void WebPageBlink::resumeWebPageAll()
@@ -457,6 +457,7 @@ void WebPageBlink::resumeWebPageAll()
     // set visibility : visible (dispatch visibilitychange event)
     // set send to plugin about this visibility change
     if (shouldStopJSOnSuspend()) {
+        suspendDelayEnded(m_isSuspended && !m_domSuspendTimer.isRunning() && !m_suspendAtLoad);
         resumeWebPagePaintingAndJSExecution();
     }
     resumeWebPageMedia();
@@ -521,6 +522,33 @@ void WebPageBlink::suspendWebPagePaintingAndJSExecution()
     }
 }
 
+bool WebPageBlink::expireDOMSuspendDelay()
+{
+    if (!m_domSuspendTimer.isRunning())
+        return false;
+
+    suspendWebPagePaintingAndJSExecution();
+    return true;
+}
+
+void WebPageBlink::expireLearnedSuspendDelay()
+{
+    if (!m_domSuspendTimer.isRunning() || !m_suspendDelayLearned)
+        return;
+
+    m_suspendDelayLearned = false;
+    m_domSuspendTimer.stop();
+
+    int elapsed = (LaunchTimeline::now() - m_domSuspendStarted) / 1000;
+    if (elapsed >= suspendDelay()) {
+        suspendWebPagePaintingAndJSExecution();
+        return;
+    }
+    m_domSuspendTimer.start(suspendDelay() - elapsed,
+                            this,
+                            &WebPageBlink::suspendWebPagePaintingAndJSExecution);
+}
+
 void WebPageBlink::resumeWebPagePaintingAndJSExecution()
 {
     LOG_INFO(MSGID_RESUME_WEBPAGE, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "%s; m_isSuspended : %s ", __func__, m_isSuspended ? "true" : "false; nothing to resume");
@@ -536,16 +564,79 @@ void WebPageBlink::resumeWebPagePaintingAndJSExecution()
             LOG_INFO(MSGID_RESUME_WEBPAGE, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "DONE");
         }
         m_isSuspended = false;
+        flushDeferredEvents();
     }
 }
 
+bool WebPageBlink::isDOMSuspended() const
+{
+    return m_isSuspended && shouldStopJSOnSuspend() && !m_domSuspendTimer.isRunning() && !m_suspendAtLoad;
+}
+
+void WebPageBlink::sendEvent(const QString& type, const QString& jsCode, bool allFrames)
+{
+    if (!isDOMSuspended()) {
+        WebPageBase::sendEvent(type, jsCode, allFrames);
+        return;
+    }
+
+    // Running it now would wake the renderer; on resume only the latest
+    // event of each type is of interest
+    sDeferredEvents++;
+    m_deferredEvents.insert(type, DeferredEvent{jsCode, allFrames});
+}
+
+void WebPageBlink::flushDeferredEvents()
+{
+    // Injection data held while suspended goes first; events may read it
+    flushExtensionData();
+    if (m_deferredEvents.isEmpty())
+        return;
+
+    LOG_INFO(MSGID_RESUME_WEBPAGE, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "Replay %d deferred events", m_deferredEvents.size());
+    QMap<QString, DeferredEvent> events;
+    events.swap(m_deferredEvents);
+    for (auto it = events.constBegin(); it != events.constEnd(); ++it) {
+        sReplayedEvents++;
+        WebPageBase::sendEvent(it.key(), it.value().script, it.value().allFrames);
+    }
+}
+
+QJsonObject WebPageBlink::deferredEventStats()
+{
+    QJsonObject stats;
+    stats["deferred"] = static_cast<int>(sDeferredEvents);
+    stats["replayed"] = static_cast<int>(sReplayedEvents);
+    stats["wakeupsAvoided"] = static_cast<int>(sDeferredEvents - sReplayedEvents);
+    return stats;
+}
+
 QString WebPageBlink::escapeData(const QString& value)
 {
-    QString escapedValue(value);
-    escapedValue.replace("\\", "\\\\")
-                .replace("'", "\\'")
-                .replace("\n", "\\n")
-                .replace("\r", "\\r");
+    // One pass over the value; most values have nothing to escape
+    int i = 0;
+    const int length = value.length();
+    for (; i < length; ++i) {
+        const ushort c = value.at(i).unicode();
+        if (c == '\\' || c == '\'' || c == '\n' || c == '\r')
+            break;
+    }
+    if (i == length)
+        return value;
+
+    QString escapedValue;
+    escapedValue.reserve(length + 8);
+    escapedValue.append(value.constData(), i);
+    for (; i < length; ++i) {
+        const QChar c = value.at(i);
+        switch (c.unicode()) {
+            case '\\': escapedValue.append(QLatin1String("\\\\")); break;
+            case '\'': escapedValue.append(QLatin1String("\\'")); break;
+            case '\n': escapedValue.append(QLatin1String("\\n")); break;
+            case '\r': escapedValue.append(QLatin1String("\\r")); break;
+            default: escapedValue.append(c); break;
+        }
+    }
     return escapedValue;
 }
 
@@ -557,6 +648,8 @@ void WebPageBlink::reloadExtensionData()
        "};"
     );
     LOG_INFO(MSGID_PALMSYSTEM, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "Reload");
+    // Reload supersedes anything still pending
+    dropExtensionData();
     evaluateJavaScript(eventJS);
 }
 
@@ -569,14 +662,86 @@ void WebPageBlink::updateExtensionData(const QString& key, const QString& value)
             "webOSSystem is not initialized. key:%s, value:%s", qPrintable(key), qPrintable(value));
         return;
     }
-    QString eventJS = QStringLiteral(
-       "if (typeof(webOSSystem) != 'undefined') {"
-       "  webOSSystem.updateInjectionData('%1', '%2');"
-       "};"
-    ).arg(escapeData(key)).arg(escapeData(value));
     LOG_INFO(MSGID_PALMSYSTEM, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "Update; key:%s; value:%s",
         qPrintable(key), qPrintable(value));
-    evaluateJavaScript(eventJS);
+    sExtensionDataUpdates++;
+    // Updates from one main loop iteration (locale, country, launch params...)
+    // reach the renderer as a single script
+    m_pendingExtensionData.insert(key, value);
+    // A suspended page gets it when it resumes
+    if (isDOMSuspended())
+        return;
+    if (!m_extensionDataTimer.isRunning())
+        m_extensionDataTimer.start(0, this, &WebPageBlink::flushExtensionData);
+}
+
+void WebPageBlink::flushExtensionData()
+{
+    if (m_extensionDataTimer.isRunning())
+        m_extensionDataTimer.stop();
+    if (m_pendingExtensionData.isEmpty())
+        return;
+
+    QString eventJS = QStringLiteral("if (typeof(webOSSystem) != 'undefined') {");
+    for (auto it = m_pendingExtensionData.constBegin(); it != m_pendingExtensionData.constEnd(); ++it) {
+        eventJS += QStringLiteral("  webOSSystem.updateInjectionData('");
+        eventJS += escapeData(it.key());
+        eventJS += QStringLiteral("', '");
+        eventJS += escapeData(it.value());
+        eventJS += QStringLiteral("');");
+    }
+    eventJS += QStringLiteral("};");
+    m_pendingExtensionData.clear();
+
+    sExtensionDataScripts++;
+    d->pageView->RunJavaScript(eventJS.toStdString());
+}
+
+void WebPageBlink::dropExtensionData()
+{
+    if (m_extensionDataTimer.isRunning())
+        m_extensionDataTimer.stop();
+    m_pendingExtensionData.clear();
+}
+
+void WebPageBlink::updatePreferences()
+{
+    sPreferenceUpdates++;
+    // Every UpdatePreferences() sends the full preference set to the
+    // renderer; changes made in one main loop iteration share one push
+    m_preferencesDirty = true;
+    if (!m_preferencesTimer.isRunning())
+        m_preferencesTimer.start(0, this, &WebPageBlink::commitPreferences);
+}
+
+void WebPageBlink::commitPreferences()
+{
+    // The timer is no longer running by the time it calls this
+    if (!m_preferencesDirty)
+        return;
+
+    m_preferencesDirty = false;
+    if (m_preferencesTimer.isRunning())
+        m_preferencesTimer.stop();
+    m_preferencePushes++;
+    sPreferencePushes++;
+    d->pageView->UpdatePreferences();
+}
+
+QJsonObject WebPageBlink::preferenceStats()
+{
+    QJsonObject stats;
+    stats["updates"] = static_cast<int>(sPreferenceUpdates);
+    stats["pushes"] = static_cast<int>(sPreferencePushes);
+    return stats;
+}
+
+QJsonObject WebPageBlink::extensionDataStats()
+{
+    QJsonObject stats;
+    stats["updates"] = static_cast<int>(sExtensionDataUpdates);
+    stats["scripts"] = static_cast<int>(sExtensionDataScripts);
+    return stats;
 }
 
 void WebPageBlink::handleDeviceInfoChanged(const QString& deviceInfo)
@@ -590,11 +755,14 @@ void WebPageBlink::handleDeviceInfoChanged(const QString& deviceInfo)
 
 void WebPageBlink::evaluateJavaScript(const QString& jsCode)
 {
+    // Scripts may read injection data; keep them behind pending updates
+    flushExtensionData();
     d->pageView->RunJavaScript(jsCode.toStdString());
 }
 
 void WebPageBlink::evaluateJavaScriptInAllFrames(const QString &script, const char *method)
 {
+    flushExtensionData();
     d->pageView->RunJavaScriptInAllFrames(script.toStdString());
 }
 
@@ -671,6 +839,8 @@ void WebPageBlink::didStartNavigation(const std::string& url, bool isInMainFrame
     // moved from loadStarted
     m_hasCloseCallback = false;
     handleLoadStarted();
+    if (isInMainFrame)
+        FOR_EACH_OBSERVER(WebPageObserver, m_observers, navigationStarted());
     LOG_INFO(MSGID_LOAD, 2,
         PMLOGKS("APP_ID", qPrintable(appId())),
         PMLOGKFV("PID", "%d", getWebProcessPID()),
@@ -757,6 +927,9 @@ void WebPageBlink::forwardEvent(void* event)
 void WebPageBlink::recreateWebView()
 {
     LOG_INFO(MSGID_WEBPROC_CRASH, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "recreateWebView; initialize WebPage");
+    // The reloaded document gets fresh injection data and no stale events
+    dropExtensionData();
+    m_deferredEvents.clear();
     delete d->pageView;
     if(!m_customPluginPath.isEmpty()) {
         // check setCustomPluginIfNeeded logic
@@ -824,7 +997,10 @@ void WebPageBlink::didFinishLaunchingSlot()
 // functions from webappmanager2
 BlinkWebView * WebPageBlink::createPageView()
 {
-    return new BlinkWebView();
+    // Spare views are for launches; a discarded page makes do with a bare one
+    if (m_discarded)
+        return new BlinkWebView();
+    return BlinkWebViewPool::instance()->take();
 }
 
 BlinkWebView* WebPageBlink::pageView() const
@@ -923,7 +1099,7 @@ void WebPageBlink::setPageProperties()
     }
 
     setTrustLevel(defaultTrustLevel());
-    d->pageView->UpdatePreferences();
+    updatePreferences();
 }
 
 void WebPageBlink::createPalmSystem(WebAppBase* app)
@@ -1038,18 +1214,28 @@ void WebPageBlink::updateBoardType()
 
 void WebPageBlink::updateMediaCodecCapability()
 {
-    QFile file("/etc/umediaserver/device_codec_capability_config.json");
-    if (!file.exists())
-        return;
+    // The capability file is part of the image; read it for the first page only
+    static bool s_capabilityRead = false;
+    static bool s_hasCapability = false;
+    static std::string s_capability;
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return;
+    if (!s_capabilityRead) {
+        s_capabilityRead = true;
+
+        QFile file("/etc/umediaserver/device_codec_capability_config.json");
+        if (!file.exists())
+            return;
+
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return;
 
-    QString capability;
-    QTextStream in(&file);
-    capability.append(in.readAll());
+        QTextStream in(&file);
+        s_capability = in.readAll().toStdString();
+        s_hasCapability = true;
+    }
 
-    d->pageView->SetMediaCodecCapability(capability.toStdString());
+    if (s_hasCapability)
+        d->pageView->SetMediaCodecCapability(s_capability);
 }
 
 double WebPageBlink::devicePixelRatio()
@@ -1125,7 +1311,7 @@ void WebPageBlink::setInspectorEnable()
 void WebPageBlink::setKeepAliveWebApp(bool keepAlive) {
     LOG_INFO(MSGID_WAM_DEBUG, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "setKeepAliveWebApp(%s)", keepAlive?"true":"false");
     d->pageView->SetKeepAliveWebApp(keepAlive);
-    d->pageView->UpdatePreferences();
+    updatePreferences();
 }
 
 void WebPageBlink::setLoadErrorPolicy(const QString& policy)
@@ -1171,7 +1357,7 @@ void WebPageBlink::keyboardVisibilityChanged(bool visible)
         "    keyboardStateEvent.visibility = %3;"
         "    if(document) document.dispatchEvent(keyboardStateEvent);"
     ).arg(visible ? "true" : "false").arg(visible ? "true" : "false").arg(visible ? "true" : "false");
-    evaluateJavaScript(javascript);
+    sendEvent(QStringLiteral("keyboardStateChange"), javascript);
 }
 
 void WebPageBlink::updateIsLoadErrorPageFinish()
@@ -1203,10 +1389,53 @@ void WebPageBlink::deactivateRendererCompositor()
     d->pageView->DeactivateRendererCompositor();
 }
 
+bool WebPageBlink::discard()
+{
+    if (m_discarded || isClosing())
+        return false;
+
+    LOG_INFO(MSGID_BACKGROUND_TIER, 2, PMLOGKS("APP_ID", qPrintable(appId())), PMLOGKFV("PID", "%d", getWebProcessPID()), "Discard web view; url : %s", qPrintable(truncateURL(url().toString())));
+    if (m_domSuspendTimer.isRunning())
+        m_domSuspendTimer.stop();
+    dropExtensionData();
+    m_deferredEvents.clear();
+
+    m_discarded = true;
+    m_discardedUrl = url();
+    d->m_palmSystem->resetInitialized();
+    delete d->pageView;
+    // check setCustomPluginIfNeeded logic
+    m_customPluginPath = "";
+    init();
+
+    // Nothing is loaded in the new view to suspend or to relaunch into
+    m_isSuspended = false;
+    m_isPaused = false;
+    m_suspendAtLoad = false;
+    m_hasBeenShown = false;
+    return true;
+}
+
+void WebPageBlink::restoreDiscarded()
+{
+    if (!m_discarded)
+        return;
+
+    LOG_INFO(MSGID_BACKGROUND_TIER, 1, PMLOGKS("APP_ID", qPrintable(appId())), "Load discarded page again");
+    m_discarded = false;
+    // The app may have navigated away from its entry point
+    if (m_discardedUrl.isEmpty()) {
+        load();
+    } else {
+        loadUrl(m_discardedUrl.toString().toStdString());
+        m_discardedUrl.clear();
+    }
+}
+
 void WebPageBlink::setAudioGuidanceOn(bool on)
 {
     d->pageView->SetAudioGuidanceOn(on);
-    d->pageView->UpdatePreferences();
+    updatePreferences();
 }
 
 void WebPageBlink::updateBackHistoryAPIDisabled()
@@ -17,6 +17,8 @@
 #ifndef WEBPAGEBLINK_H
 #define WEBPAGEBLINK_H
 
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
 #include <QtCore/QUrl>
 
 #include "Timer.h"
@@ -33,7 +35,7 @@ class WebPageBlinkObserver;
 class WebPageBlink : public WebPageBase, public WebPageBlinkDelegate {
     Q_OBJECT
 public:
-    WebPageBlink(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const QString& launchParams);
+    WebPageBlink(const QUrl& url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& launchParams);
     ~WebPageBlink() override;
 
     void setObserver(WebPageBlinkObserver* observer);
@@ -41,7 +43,7 @@ public:
     // WebPageBase
     void init() override;
     void* getWebContents() override;
-    void setLaunchParams(const QString& params) override;
+    void setLaunchParams(const LaunchParams& params) override;
     void notifyMemoryPressure(webos::WebViewBase::MemoryPressureLevel level) override;
     QUrl url() const override;
     void loadUrl(const std::string& url) override;
@@ -62,6 +64,7 @@ public:
     void handleDeviceInfoChanged(const QString& deviceInfo) override;
     void evaluateJavaScript(const QString& jsCode) override;
     void evaluateJavaScriptInAllFrames(const QString& jsCode, const char* method = "") override;
+    void sendEvent(const QString& type, const QString& jsCode, bool allFrames = false) override;
     void setForceActivateVtg(bool enabled) override;
     uint32_t getWebProcessProxyID() override;
     uint32_t getWebProcessPID() const override { return renderProcessPid(); }
@@ -75,6 +78,8 @@ public:
     void suspendWebPageMedia() override;
     void resumeWebPageMedia() override;
     void resumeWebPagePaintingAndJSExecution() override;
+    bool expireDOMSuspendDelay() override;
+    void expireLearnedSuspendDelay() override;
     bool isRegisteredCloseCallback() override { return m_hasCloseCallback; }
     void reloadExtensionData() override;
     void updateIsLoadErrorPageFinish() override;
@@ -115,6 +120,13 @@ public:
     void didErrorPageLoadedFromNetErrorHelper() override;
 
     void updateExtensionData(const QString& key, const QString& value);
+    // Updates requested versus update scripts sent to renderers
+    static QJsonObject extensionDataStats();
+    // Events held for suspended pages versus replayed on resume
+    static QJsonObject deferredEventStats();
+    // Preference updates requested versus pushes to renderers
+    static QJsonObject preferenceStats();
+    unsigned preferencePushes() const { return m_preferencePushes; }
     void setLoadErrorPolicy(const QString& policy);
     void setTrustLevel(const QString& trustLevel) { m_trustLevel = trustLevel; }
     QString trustLevel() const { return m_trustLevel; }
@@ -134,6 +146,9 @@ public:
     void didSwapCompositorFrame();
     void activateRendererCompositor() override;
     void deactivateRendererCompositor() override;
+    bool discard() override;
+    bool isDiscarded() const override { return m_discarded; }
+    void restoreDiscarded() override;
 
     void didResumeDOM() override;
 
@@ -179,6 +194,14 @@ protected Q_SLOTS:
 private:
     void setCustomPluginIfNeeded();
     void setDisallowScrolling(bool disallow);
+    void flushExtensionData();
+    void dropExtensionData();
+    bool isDOMSuspended() const;
+    void flushDeferredEvents();
+    // Records preference changes; commitPreferences() pushes them to the
+    // renderer, on the next main loop iteration or before a navigation
+    void updatePreferences();
+    void commitPreferences();
 
 private:
     WebPageBlinkPrivate* d;
@@ -187,16 +210,30 @@ private:
     bool m_isSuspended;
     bool m_hasCustomPolicyForResponse;
     bool m_hasBeenShown;
+    bool m_discarded;
+    QUrl m_discardedUrl; // where the page was when it was discarded
     OneShotTimer<WebPageBlink> m_domSuspendTimer;
     QString m_customPluginPath;
     qreal m_vkbHeight;
     bool m_vkbWasOverlap;
     bool m_hasCloseCallback;
     OneShotTimer<WebPageBlink> m_closeCallbackTimer;
+    QMap<QString, QString> m_pendingExtensionData; // latest value per key until the next flush
+    OneShotTimer<WebPageBlink> m_extensionDataTimer;
+    struct DeferredEvent {
+        QString script;
+        bool allFrames;
+    };
+    QMap<QString, DeferredEvent> m_deferredEvents; // latest event per type while DOM is suspended
     QString m_trustLevel;
     QString m_loadFailedHostname;
     std::string m_loadingUrl;
     int m_customSuspendDOMTime;
+    int64_t m_domSuspendStarted;
+    bool m_suspendDelayLearned; // m_domSuspendTimer runs a learned delay
+    bool m_preferencesDirty; // changes not pushed to the renderer yet
+    OneShotTimer<WebPageBlink> m_preferencesTimer;
+    unsigned m_preferencePushes;
 
     WebPageBlinkObserver *m_observer;
 };
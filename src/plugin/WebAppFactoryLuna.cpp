@@ -46,7 +46,7 @@ WebAppBase* WebAppFactoryLuna::createWebApp(QString winType, WebPageBase* page,
     return createWebApp(winType, desc);
 }
 
-WebPageBase* WebAppFactoryLuna::createWebPage(QUrl url, std::shared_ptr<ApplicationDescription> desc, QString launchParams)
+WebPageBase* WebAppFactoryLuna::createWebPage(QUrl url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& launchParams)
 {
     return new WebPageBlink(url, desc, launchParams);
 }
@@ -30,7 +30,7 @@ class WebAppFactoryLuna : public QObject,
 public:
     virtual WebAppBase* createWebApp(QString winType, std::shared_ptr<ApplicationDescription> desc = nullptr);
     virtual WebAppBase* createWebApp(QString winType, WebPageBase* page, std::shared_ptr<ApplicationDescription> desc = nullptr);
-    virtual WebPageBase* createWebPage(QUrl url, std::shared_ptr<ApplicationDescription> desc, QString launchParams = "");
+    virtual WebPageBase* createWebPage(QUrl url, std::shared_ptr<ApplicationDescription> desc, const LaunchParams& launchParams = LaunchParams());
 };
 
 #endif /* WEBAPPFACTORYLUNA_H */
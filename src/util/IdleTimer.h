@@ -0,0 +1,93 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef IDLETIMER_H
+#define IDLETIMER_H
+
+#include <algorithm>
+
+#include "Timer.h"
+#include "WebAppManagerUtils.h"
+
+/**
+ * Runs background work only while WAM is idle.
+ *
+ * The method is called |delay| ms after the last start(), provided the
+ * cpu was at least |minCpuIdle| (per mille) idle over that wait; while it
+ * is busier the check is repeated after another delay. Restarting pushes
+ * the work back, so a burst of launches runs it once, after the burst.
+ * Each IdleTimer keeps its own /proc/stat snapshot, so timers checking in
+ * the same wakeup measure their own waits.
+ */
+template <class Receiver>
+class IdleTimer {
+public:
+    typedef void (Receiver::*ReceiverMethod)();
+
+    IdleTimer()
+        : m_receiver(nullptr)
+        , m_method(nullptr)
+        , m_delay(0)
+        , m_minCpuIdle(0)
+        , m_cpuTime()
+    {
+        // Nobody waits for idle work; let it share wakeups
+        m_timer.setSlack(1000);
+    }
+
+    void start(int delayInMilliSeconds, int minCpuIdle, Receiver* receiver, ReceiverMethod method)
+    {
+        // Cpu idle is measured from the first start() of a wait
+        if (!m_timer.isRunning())
+            WebAppManagerUtils::readCpuTimes(m_cpuTime);
+
+        m_receiver = receiver;
+        m_method = method;
+        m_delay = delayInMilliSeconds;
+        m_minCpuIdle = minCpuIdle;
+        m_timer.stop();
+        m_timer.start(m_delay, this, &IdleTimer::check);
+    }
+
+    void stop() { m_timer.stop(); }
+    bool isRunning() const { return m_timer.isRunning(); }
+
+private:
+    void check()
+    {
+        long cpuTime[4];
+        if (WebAppManagerUtils::readCpuTimes(cpuTime)) {
+            int idle = WebAppManagerUtils::cpuIdleBetween(m_cpuTime, cpuTime);
+            // The next wait is measured on its own
+            std::copy(cpuTime, cpuTime + 4, m_cpuTime);
+            if (idle < m_minCpuIdle) {
+                m_timer.start(m_delay, this, &IdleTimer::check);
+                return;
+            }
+        }
+        (m_receiver->*m_method)();
+    }
+
+    OneShotTimer<IdleTimer<Receiver> > m_timer;
+    Receiver* m_receiver;
+    ReceiverMethod m_method;
+    int m_delay;
+    int m_minCpuIdle;
+    long m_cpuTime[4]; // at the start of the current wait
+};
+
+#endif /* IDLETIMER_H */
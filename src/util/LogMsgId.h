@@ -25,6 +25,8 @@
 // Instrumentation for app launch timing logging
 #define MSGID_APPLAUNCH_START        "APPLAUNCH_START" /** Start of app launch process */
 #define MSGID_APP_LOADED              "APPLOADED" /** New App/Page load, gives APP_ID and page URL */
+#define MSGID_APPLAUNCH_DONE         "APPLAUNCH_DONE" /** Last frame of app launch swapped, launch timeline recorded */
+#define MSGID_PREDICTIVE_PRELOAD     "PREDICTIVE_PRELOAD" /** App preloaded as a likely next launch */
 
 #define MSGID_WINDOW_CLOSED          "WINDOW_CLOSED" /* An application window closed by QCloseEvent */
 #define MSGID_WINDOW_CLOSED_JS       "WINDOW_CLOSED_JS" /* Application window closed by javascript */
@@ -153,6 +155,9 @@
 #define MSGID_NETWORKSTATUS_INFO        "NETWORKSTATUS_INFO" /** Printing NetworkStatus Information*/
 
 #define MSGID_NOTIFY_MEMORY_STATE            "NOTIFY_MEMORY_STATE" /** Send memory state*/
+#define MSGID_MEMORY_EVICT                   "MEMORY_EVICT" /** Background app closed to recover memory */
+#define MSGID_RENDERER_PRIORITY              "RENDERER_PRIORITY" /** Renderer CPU and I/O priority by foreground state */
+#define MSGID_BACKGROUND_TIER                "BACKGROUND_TIER" /** Hidden app moved between background tiers */
 
 #define MSGID_TYPE_ERROR                  "DATA_TYPE_ERROR" /** Use a invalid data type **/
 
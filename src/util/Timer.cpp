@@ -15,40 +15,319 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Timer.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+
 #include <glib.h>
 
-static int timeout_cb(void* data)
+#include <QJsonObject>
+
+static gboolean dispatchTimerWheel(GSource*, GSourceFunc, gpointer)
 {
-    Timer* timer = (Timer*) data;
-    bool isRepeating = timer->isRepeating();
-    timer->handleCallback();
-    return isRepeating;
+    TimerWheel::instance()->dispatch();
+    return G_SOURCE_CONTINUE;
 }
 
-static int timeout_cb_destroy(void* data)
+// No prepare or check; the ready time is all it takes
+static GSourceFuncs timerWheelSourceFuncs = {
+    nullptr, nullptr, dispatchTimerWheel, nullptr, nullptr, nullptr
+};
+
+Timer::Timer(bool isRepeating, const char* owner)
+    : m_isRunning(false)
+    , m_isRepeating(isRepeating)
+    , m_willDestroy(false)
+    , m_interval(0)
+    , m_slack(0)
+    , m_deadline(0)
+    , m_owner(owner)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+    , m_list(nullptr)
 {
-    Timer* timer = (Timer*) data;
-    timer->handleCallback();
-    delete timer;
-    return 0;
+}
+
+Timer::~Timer()
+{
+    if (m_list)
+        TimerWheel::instance()->remove(this);
+}
+
+const char* Timer::ownerName(const char* prettyFunction)
+{
+    // Names are kept for good; there is one per receiver type
+    static std::set<std::string> names;
+
+    // "... [with Receiver = Foo; ..." (gcc) or "... [Receiver = Foo, ..." (clang)
+    std::string function(prettyFunction);
+    std::string::size_type begin = function.find("Receiver = ");
+    if (begin == std::string::npos)
+        return "Timer";
+    begin += sizeof("Receiver = ") - 1;
+    std::string::size_type end = function.find_first_of(";,]", begin);
+    return names.insert(function.substr(begin, end - begin)).first->c_str();
 }
 
 void Timer::start(int delayInMilliSeconds, bool willDestroy)
 {
+    // Starting a running timer starts it over
+    TimerWheel* wheel = TimerWheel::instance();
+    if (m_list)
+        wheel->remove(this);
+
     m_isRunning = true;
-    if (!willDestroy)
-        m_sourceId = g_timeout_add(delayInMilliSeconds, timeout_cb, this);
-    else
-        m_sourceId = g_timeout_add(delayInMilliSeconds, timeout_cb_destroy, this);
+    m_willDestroy = willDestroy;
+    m_interval = std::max(delayInMilliSeconds, 0);
+    wheel->add(this);
 }
 
 void Timer::stop()
 {
+    if (m_list)
+        TimerWheel::instance()->remove(this);
     m_isRunning = false;
-    if (m_sourceId) {
-        g_source_remove(m_sourceId);
-        m_sourceId = 0;
+}
+
+TimerWheel* TimerWheel::instance()
+{
+    // not a leak -- static variable initializations are only ever done once
+    static TimerWheel* sInstance = new TimerWheel();
+    return sInstance;
+}
+
+TimerWheel::TimerWheel()
+    : m_slots()
+    , m_expired(nullptr)
+    , m_now(g_get_monotonic_time() / 1000)
+    , m_skipped(0)
+    , m_source(g_source_new(&timerWheelSourceFuncs, sizeof(GSource)))
+    , m_timers(0)
+    , m_wakeups(0)
+    , m_fired(0)
+    , m_recentSecond()
+    , m_recentWakeups()
+{
+    g_source_set_name(m_source, "TimerWheel");
+    g_source_attach(m_source, nullptr);
+}
+
+int64_t TimerWheel::now() const
+{
+    return g_get_monotonic_time() / 1000 + m_skipped;
+}
+
+void TimerWheel::skip(int milliSeconds)
+{
+    m_skipped += std::max(milliSeconds, 0);
+    updateReadyTime();
+}
+
+void TimerWheel::add(Timer* timer)
+{
+    int64_t now = this->now();
+    advance(now);
+
+    int64_t deadline = now + timer->m_interval;
+    if (timer->m_slack > 1)
+        deadline = (deadline + timer->m_slack - 1) / timer->m_slack * timer->m_slack;
+    timer->m_deadline = deadline;
+
+    insert(timer);
+    updateReadyTime();
+}
+
+void TimerWheel::remove(Timer* timer)
+{
+    unlink(timer);
+    updateReadyTime();
+}
+
+void TimerWheel::insert(Timer* timer)
+{
+    int64_t deadline = timer->m_deadline;
+    if (deadline <= m_now) {
+        link(&m_expired, timer);
+        return;
+    }
+
+    for (int level = 0; level < kLevels; level++) {
+        int shift = level * kSlotBits;
+        if ((deadline >> shift) - (m_now >> shift) < kSlots) {
+            link(&m_slots[level][(deadline >> shift) & (kSlots - 1)], timer);
+            return;
+        }
     }
+
+    // Further out than the wheel reaches; it is placed again when the
+    // last slot of the top level comes up
+    int shift = (kLevels - 1) * kSlotBits;
+    link(&m_slots[kLevels - 1][((m_now >> shift) + kSlots - 1) & (kSlots - 1)], timer);
+}
+
+void TimerWheel::advance(int64_t now)
+{
+    if (now <= m_now)
+        return;
+
+    // Slots that have come up since m_now, at most a full turn of each level
+    Timer* due = nullptr;
+    for (int level = 0; level < kLevels; level++) {
+        int shift = level * kSlotBits;
+        int64_t from = m_now >> shift;
+        int64_t count = std::min<int64_t>((now >> shift) - from, kSlots);
+        for (int64_t i = 1; i <= count; i++) {
+            Timer** slot = &m_slots[level][(from + i) & (kSlots - 1)];
+            while (Timer* timer = *slot) {
+                unlink(timer);
+                link(&due, timer);
+            }
+        }
+    }
+
+    // Expired timers go on the expired list, the others down a level
+    m_now = now;
+    while (Timer* timer = due) {
+        unlink(timer);
+        insert(timer);
+    }
+}
+
+int64_t TimerWheel::nextDeadline() const
+{
+    if (m_expired)
+        return m_now;
+
+    // The first occupied slot of each level holds that level's earliest
+    int64_t next = -1;
+    for (int level = 0; level < kLevels; level++) {
+        int shift = level * kSlotBits;
+        int64_t current = m_now >> shift;
+        for (int i = 1; i < kSlots; i++) {
+            Timer* timer = m_slots[level][(current + i) & (kSlots - 1)];
+            if (!timer)
+                continue;
+            for (; timer; timer = timer->m_next) {
+                if (next < 0 || timer->m_deadline < next)
+                    next = timer->m_deadline;
+            }
+            break;
+        }
+    }
+    return next;
+}
+
+void TimerWheel::updateReadyTime()
+{
+    int64_t next = nextDeadline();
+    g_source_set_ready_time(m_source, next < 0 ? -1 : (next - m_skipped) * 1000);
+}
+
+void TimerWheel::dispatch()
+{
+    int64_t now = this->now();
+    advance(now);
+
+    m_wakeups++;
+    int64_t second = now / 1000;
+    int recent = static_cast<int>(second % kRecentSeconds);
+    if (m_recentSecond[recent] != second) {
+        m_recentSecond[recent] = second;
+        m_recentWakeups[recent] = 0;
+    }
+    m_recentWakeups[recent]++;
+
+    // Only what is due now; timers started from callbacks wait for the
+    // next wakeup, even with no delay
+    Timer* due = nullptr;
+    while (Timer* timer = m_expired) {
+        unlink(timer);
+        link(&due, timer);
+    }
+
+    while (due) {
+        Timer* timer = due;
+        for (Timer* other = due->m_next; other; other = other->m_next) {
+            if (other->m_deadline < timer->m_deadline)
+                timer = other;
+        }
+        unlink(timer);
+
+        m_fired++;
+        OwnerStats& owner = m_owners[timer->m_owner];
+        owner.fired++;
+        if (owner.lastWakeup != m_wakeups) {
+            owner.lastWakeup = m_wakeups;
+            owner.wakeups++;
+        }
+
+        if (timer->m_isRepeating)
+            add(timer);
+
+        // The callback may stop, start or delete any timer, this one too
+        bool willDestroy = timer->m_willDestroy;
+        timer->handleCallback();
+        if (willDestroy)
+            delete timer;
+    }
+
+    updateReadyTime();
+}
+
+void TimerWheel::link(Timer** list, Timer* timer)
+{
+    timer->m_list = list;
+    timer->m_prev = nullptr;
+    timer->m_next = *list;
+    if (*list)
+        (*list)->m_prev = timer;
+    *list = timer;
+    m_timers++;
+}
+
+void TimerWheel::unlink(Timer* timer)
+{
+    if (!timer->m_list)
+        return;
+
+    if (timer->m_prev)
+        timer->m_prev->m_next = timer->m_next;
+    else
+        *timer->m_list = timer->m_next;
+    if (timer->m_next)
+        timer->m_next->m_prev = timer->m_prev;
+
+    timer->m_list = nullptr;
+    timer->m_prev = nullptr;
+    timer->m_next = nullptr;
+    m_timers--;
+}
+
+QJsonObject TimerWheel::stats() const
+{
+    int64_t second = now() / 1000;
+    unsigned recentWakeups = 0;
+    for (int i = 0; i < kRecentSeconds; i++) {
+        if (second - m_recentSecond[i] < kRecentSeconds)
+            recentWakeups += m_recentWakeups[i];
+    }
+
+    QJsonObject owners;
+    for (const auto& owner : m_owners) {
+        QJsonObject ownerStats;
+        ownerStats["wakeups"] = static_cast<double>(owner.second.wakeups);
+        ownerStats["fired"] = static_cast<double>(owner.second.fired);
+        owners[owner.first] = ownerStats;
+    }
+
+    QJsonObject stats;
+    stats["timers"] = static_cast<int>(m_timers);
+    stats["wakeups"] = static_cast<double>(m_wakeups);
+    stats["fired"] = static_cast<double>(m_fired);
+    stats["wakeupsPerSecond"] = static_cast<double>(recentWakeups) / kRecentSeconds;
+    stats["owners"] = owners;
+    return stats;
 }
 
 ElapsedTimer::ElapsedTimer()
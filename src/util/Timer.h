@@ -17,33 +17,117 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <stdint.h>
+
+#include <unordered_map>
+
+class QJsonObject;
+typedef struct _GSource GSource;
 typedef struct _GTimer GTimer;
 
 class Timer {
 public:
-    Timer(bool isRepeating)
-        : m_sourceId(0)
-        , m_isRunning(false)
-        , m_isRepeating(isRepeating)
-    {
-    }
-    virtual ~Timer() {}
+    Timer(bool isRepeating, const char* owner = "Timer");
+    virtual ~Timer();
 
     // Timer
     virtual void handleCallback() = 0;
     virtual void start(int delayInMilliSeconds, bool willDestroy = false);
 
-    bool isRunning() { return m_isRunning; }
+    bool isRunning() const { return m_isRunning; }
     bool isRepeating() { return m_isRepeating; }
     void stop();
 
+    // Lets the timer fire up to |slackInMilliSeconds| late, on a multiple of
+    // it, so that it shares a wakeup with other timers due around then
+    void setSlack(int slackInMilliSeconds) { m_slack = slackInMilliSeconds; }
+
 protected:
     void running(bool isRunning) { m_isRunning = isRunning; }
 
+    // Receiver type named in the __PRETTY_FUNCTION__ of a BaseTimer method
+    static const char* ownerName(const char* prettyFunction);
+
 private:
-    int m_sourceId;
+    friend class TimerWheel;
+
     bool m_isRunning;
     bool m_isRepeating;
+    bool m_willDestroy;
+    int m_interval;
+    int m_slack;
+    int64_t m_deadline; // ms of g_get_monotonic_time()
+    const char* m_owner;
+
+    // Links of the list the timer is queued in, if any
+    Timer* m_prev;
+    Timer* m_next;
+    Timer** m_list;
+};
+
+/**
+ * Runs every Timer off a single GSource on the default main context.
+ *
+ * Timers are kept in a hierarchical wheel of kLevels levels of kSlots
+ * slots each: a level 0 slot spans 1 ms, and each level's slots span
+ * kSlots times those of the level below. A timer sits in the lowest
+ * level that reaches its deadline, and moves down as its slot comes up.
+ * Adding and removing timers is constant time, and the GSource is only
+ * woken for the earliest deadline.
+ *
+ * Timers given slack are rounded up to a multiple of it, so that those
+ * due around the same time fire in one wakeup.
+ */
+class TimerWheel {
+public:
+    static TimerWheel* instance();
+
+    void add(Timer* timer);
+    void remove(Timer* timer);
+    // Fires the timers that are due; called by the GSource
+    void dispatch();
+    // Moves the wheel's clock |milliSeconds| ahead, as if that much time
+    // had passed at once; for tests
+    void skip(int milliSeconds);
+
+    QJsonObject stats() const;
+
+private:
+    static const int kSlotBits = 6;
+    static const int kSlots = 1 << kSlotBits;
+    static const int kLevels = 4;
+    static const int kRecentSeconds = 60;
+
+    struct OwnerStats {
+        OwnerStats() : wakeups(0), fired(0), lastWakeup(0) {}
+
+        uint64_t wakeups;
+        uint64_t fired;
+        uint64_t lastWakeup;
+    };
+
+    TimerWheel();
+
+    int64_t now() const; // ms of g_get_monotonic_time(), plus what was skipped
+    void insert(Timer* timer);
+    void advance(int64_t now);
+    int64_t nextDeadline() const;
+    void updateReadyTime();
+    void link(Timer** list, Timer* timer);
+    void unlink(Timer* timer);
+
+    Timer* m_slots[kLevels][kSlots];
+    Timer* m_expired;
+    int64_t m_now; // ms the wheel has been advanced to
+    int64_t m_skipped;
+    GSource* m_source;
+
+    unsigned m_timers;
+    uint64_t m_wakeups;
+    uint64_t m_fired;
+    int64_t m_recentSecond[kRecentSeconds];
+    unsigned m_recentWakeups[kRecentSeconds];
+    std::unordered_map<const char*, OwnerStats> m_owners;
 };
 
 template <class Receiver, bool kIsRepeating>
@@ -52,7 +136,7 @@ public:
     typedef void (Receiver::*ReceiverMethod)();
 
     BaseTimer()
-        : Timer(kIsRepeating)
+        : Timer(kIsRepeating, owner())
         , m_receiver(nullptr)
         , m_method(nullptr)
     {
@@ -78,6 +162,12 @@ public:
     }
 
 private:
+    static const char* owner()
+    {
+        static const char* name = ownerName(__PRETTY_FUNCTION__);
+        return name;
+    }
+
     Receiver* m_receiver;
     ReceiverMethod m_method;
 };
@@ -95,6 +185,8 @@ class SingleShotTimer : public BaseTimer<Receiver, false> {
 public:
     typedef void (Receiver::*ReceiverMethod)();
 
+    // Unlike starting a timer, this allocates one, which deletes itself
+    // once it has fired
     static void singleShot(int delayInMilliSeconds, Receiver* receiver, ReceiverMethod method)
     {
         SingleShotTimer<Receiver>* timer = new SingleShotTimer<Receiver>;
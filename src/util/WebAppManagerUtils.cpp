@@ -18,6 +18,7 @@
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <fstream>
@@ -26,38 +27,86 @@
 int WebAppManagerUtils::updateAndGetCpuIdle(bool updateOnly)
 {
     static long oldCpuTime[4];
-    long curCpuTime[4];
-    long* cpuTime = curCpuTime;
-
-    if (updateOnly)
-        cpuTime = oldCpuTime;
-
-    int fd;
-    if ((fd = open("/proc/stat", O_RDONLY)) != -1) {
-        char buffer[4096+1];
-        int len = read(fd, buffer, sizeof(buffer)-1);
-        if (len > 0) {
-            buffer[len] = '\0';
-            char* p = skipToken(buffer); /* "cpu" */
-            cpuTime[0] = strtoul(p, &p, 0);
-            cpuTime[1] = strtoul(p, &p, 0);
-            cpuTime[2] = strtoul(p, &p, 0);
-            cpuTime[3] = strtoul(p, &p, 0);
-        }
-        close(fd);
-    }
+    long curCpuTime[4] = {};
 
-    if (updateOnly)
+    if (updateOnly) {
+        readCpuTimes(oldCpuTime);
         return 1000; // max value of percentages();
+    }
 
-    long cpuDiff[4];
-    int cpuStates[4];
-    percentages(4, cpuStates, curCpuTime, oldCpuTime, cpuDiff);
+    readCpuTimes(curCpuTime);
+    int idle = cpuIdleBetween(oldCpuTime, curCpuTime);
     memcpy(oldCpuTime, curCpuTime, sizeof(oldCpuTime));
 
+    return idle;
+}
+
+bool WebAppManagerUtils::readCpuTimes(long cpuTime[4])
+{
+    int fd = open("/proc/stat", O_RDONLY);
+    if (fd == -1)
+        return false;
+
+    char buffer[4096+1];
+    int len = read(fd, buffer, sizeof(buffer)-1);
+    close(fd);
+    if (len <= 0)
+        return false;
+
+    buffer[len] = '\0';
+    char* p = skipToken(buffer); /* "cpu" */
+    cpuTime[0] = strtoul(p, &p, 0);
+    cpuTime[1] = strtoul(p, &p, 0);
+    cpuTime[2] = strtoul(p, &p, 0);
+    cpuTime[3] = strtoul(p, &p, 0);
+    return true;
+}
+
+int WebAppManagerUtils::cpuIdleBetween(const long oldCpuTime[4], const long newCpuTime[4])
+{
+    // percentages() moves |old| up to |now|; work on copies
+    long oldTime[4];
+    long newTime[4];
+    memcpy(oldTime, oldCpuTime, sizeof(oldTime));
+    memcpy(newTime, newCpuTime, sizeof(newTime));
+
+    long cpuDiff[4];
+    int cpuStates[4];
+    percentages(4, cpuStates, newTime, oldTime, cpuDiff);
     return cpuStates[3];
 }
 
+long WebAppManagerUtils::readMemInfo(const char* field)
+{
+    FILE* fp = fopen("/proc/meminfo", "r");
+    if (!fp)
+        return -1;
+
+    long value = -1;
+    size_t length = strlen(field);
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        if (!strncmp(line, field, length)) {
+            value = strtol(line + length, nullptr, 10);
+            break;
+        }
+    }
+
+    fclose(fp);
+    return value;
+}
+
+bool WebAppManagerUtils::writeFile(const std::string& path, const std::string& value, bool append)
+{
+    FILE* fp = fopen(path.c_str(), append ? "a" : "w");
+    if (!fp)
+        return false;
+
+    bool written = fwrite(value.data(), 1, value.size(), fp) == value.size();
+    // Kernel files reject a value when it is flushed, so fclose has the say
+    return fclose(fp) == 0 && written;
+}
+
 char* WebAppManagerUtils::skipToken(const char* p)
 {
     while (isspace(*p))
@@ -23,10 +23,20 @@
 class WebAppManagerUtils {
 public:
     static int updateAndGetCpuIdle(bool updateOnly = false);
+    // User, nice, system and idle time of all cpus, from /proc/stat
+    static bool readCpuTimes(long cpuTime[4]);
+    // Idle share in per mille between two readCpuTimes() snapshots
+    static int cpuIdleBetween(const long oldCpuTime[4], const long newCpuTime[4]);
+    // MemAvailable and MemTotal of /proc/meminfo in kB, -1 if unknown
+    static long getMemAvailable() { return readMemInfo("MemAvailable:"); }
+    static long getMemTotal() { return readMemInfo("MemTotal:"); }
+    // Writes |value| to a procfs, sysfs or cgroupfs file; false if it was refused
+    static bool writeFile(const std::string& path, const std::string& value, bool append = false);
     static bool setGroups();
     static std::string truncateURL(const std::string& url);
 
 private:
+    static long readMemInfo(const char* field);
     static long percentages(int cnt, int* out, long* now, long* old, long* diffs);
     static char* skipToken(const char* p);
     static void tokenize(std::string& str, std::vector<std::string>& tokens,
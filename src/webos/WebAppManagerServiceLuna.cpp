@@ -17,6 +17,8 @@
 
 #include "WebAppManagerServiceLuna.h"
 
+#include "LaunchParams.h"
+#include "LaunchTimeline.h"
 #include "LogManager.h"
 #include <QByteArray>
 #include <QJsonArray>
@@ -46,6 +48,10 @@ LSMethod WebAppManagerServiceLuna::s_methods[] = {
     LS2_METHOD_ENTRY(closeByProcessId),
     LS2_METHOD_ENTRY(clearBrowsingData),
     LS2_SUBSCRIPTION_ENTRY(listRunningApps),
+    LS2_METHOD_ENTRY(getLaunchMetrics),
+    LS2_METHOD_ENTRY(launchApps),
+    LS2_METHOD_ENTRY(killApps),
+    LS2_METHOD_ENTRY(closeByProcessIds),
     LS2_SUBSCRIPTION_ENTRY(webProcessCreated),
     { 0, 0 }
 };
@@ -68,6 +74,9 @@ bool WebAppManagerServiceLuna::startService()
 
 QJsonObject WebAppManagerServiceLuna::launchApp(QJsonObject request)
 {
+    LaunchTimeline timeline;
+    timeline.start();
+
     int errCode;
     std::string errMsg;
     QJsonObject reply;
@@ -82,8 +91,7 @@ QJsonObject WebAppManagerServiceLuna::launchApp(QJsonObject request)
         return reply;
     }
 
-    QJsonDocument doc(request["parameters"].toObject());
-    QJsonObject jsonParams = doc.object();
+    QJsonObject jsonParams = request["parameters"].toObject();
     if(request["launchHidden"].toBool()) {
         jsonParams["launchedHidden"] = true;
     }
@@ -96,19 +104,21 @@ QJsonObject WebAppManagerServiceLuna::launchApp(QJsonObject request)
     if(request["keepAlive"].toBool()) {
         jsonParams["keepAlive"] = true;
     }
-    doc.setObject(jsonParams);
-    QString params(doc.toJson());
+    // parameters are decoded here once and handed down as they are
+    LaunchParams params(jsonParams);
+    QJsonObject appDesc = request["appDesc"].toObject();
 
-    std::string appId = request["appDesc"].toObject()["id"].toString().toStdString();
+    std::string appId = appDesc["id"].toString().toStdString();
     LOG_INFO_WITH_CLOCK(MSGID_APPLAUNCH_START, 3,
                         PMLOGKS("PerfType","AppLaunch"),
                         PMLOGKS("PerfGroup", appId.c_str()),
-                        PMLOGKS("APP_ID", appId.c_str()), "params : %s", qPrintable(params));
+                        PMLOGKS("APP_ID", appId.c_str()), "params : %s", qPrintable(params.toJson()));
 
     std::string instanceId;
     instanceId = WebAppManagerService::onLaunch(
-                    QJsonDocument(request["appDesc"].toObject()).toJson().data(),
-                    params.toStdString(),
+                    appDesc,
+                    params,
+                    timeline,
                     request["launchingAppId"].toString().toStdString(),
                     errCode, errMsg);
 
@@ -119,7 +129,7 @@ QJsonObject WebAppManagerServiceLuna::launchApp(QJsonObject request)
     }
     else {
         reply["returnValue"] = true;
-        reply["appId"] = request["appDesc"].toObject()["id"];
+        reply["appId"] = appDesc["id"];
         reply["procId"] = QString::fromStdString(instanceId);
     }
     return reply;
@@ -156,6 +166,60 @@ QJsonObject WebAppManagerServiceLuna::killApp(QJsonObject request)
     return reply;
 }
 
+static QJsonObject missItemsReply()
+{
+    QJsonObject reply;
+    reply["returnValue"] = false;
+    reply["errorCode"] = ERR_CODE_BATCH_MISS_ITEMS;
+    reply["errorText"] = QString::fromStdString(err_missItems);
+    return reply;
+}
+
+// Batched variants of launchApp, killApp and closeByProcessId. The items are
+// handled in this one call and the running app list is posted once for all.
+QJsonObject WebAppManagerServiceLuna::launchApps(QJsonObject request)
+{
+    QJsonArray apps = request["apps"].toArray();
+    if (apps.isEmpty())
+        return missItemsReply();
+
+    LOG_INFO(MSGID_LUNA_API, 1, PMLOGKS("API", "launchApps"), "count : %d", apps.size());
+
+    QJsonArray results;
+    for (const QJsonValue& app : apps)
+        results.append(launchApp(app.toObject()));
+
+    QJsonObject reply;
+    reply["returnValue"] = true;
+    reply["results"] = results;
+    return reply;
+}
+
+QJsonObject WebAppManagerServiceLuna::killApps(QJsonObject request)
+{
+    QJsonArray appIds = request["appIds"].toArray();
+    if (appIds.isEmpty())
+        return missItemsReply();
+
+    LOG_INFO(MSGID_LUNA_API, 1, PMLOGKS("API", "killApps"), "count : %d", appIds.size());
+
+    QJsonArray results;
+    for (const QJsonValue& appId : appIds) {
+        QJsonObject item;
+        item["appId"] = appId.toString();
+        if (request.contains("reason"))
+            item["reason"] = request["reason"];
+        QJsonObject result = killApp(item);
+        result["appId"] = appId.toString();
+        results.append(result);
+    }
+
+    QJsonObject reply;
+    reply["returnValue"] = true;
+    reply["results"] = results;
+    return reply;
+}
+
 QJsonObject WebAppManagerServiceLuna::pauseApp(QJsonObject request)
 {
     std::string id{request["appId"].toString().toStdString()};
@@ -262,6 +326,13 @@ QJsonObject WebAppManagerServiceLuna::getWebProcessSize(QJsonObject request)
     return reply;
 }
 
+QJsonObject WebAppManagerServiceLuna::getLaunchMetrics(QJsonObject request)
+{
+    QJsonObject reply = WebAppManagerService::launchMetrics(request["appId"].toString());
+    reply["returnValue"] = true;
+    return reply;
+}
+
 QJsonObject WebAppManagerServiceLuna::listRunningApps(QJsonObject request, bool subscribed)
 {
     bool includeSysApps = request["includeSysApps"].toBool();
@@ -288,6 +359,27 @@ QJsonObject WebAppManagerServiceLuna::closeByProcessId(QJsonObject request)
     return reply;
 }
 
+QJsonObject WebAppManagerServiceLuna::closeByProcessIds(QJsonObject request)
+{
+    QJsonArray processIds = request["processIds"].toArray();
+    if (processIds.isEmpty())
+        return missItemsReply();
+
+    LOG_INFO(MSGID_LUNA_API, 1, PMLOGKS("API", "closeByProcessIds"), "count : %d", processIds.size());
+
+    QJsonArray results;
+    for (const QJsonValue& processId : processIds) {
+        QJsonObject result = WebAppManagerService::closeByInstanceId(processId.toString());
+        result["processId"] = processId.toString();
+        results.append(result);
+    }
+
+    QJsonObject reply;
+    reply["returnValue"] = true;
+    reply["results"] = results;
+    return reply;
+}
+
 QJsonObject WebAppManagerServiceLuna::clearBrowsingData(QJsonObject request)
 {
     QJsonObject reply;
@@ -470,15 +562,7 @@ void WebAppManagerServiceLuna::thresholdChangedCallback(QJsonObject reply)
         return;
     }
     LOG_INFO(MSGID_NOTIFY_MEMORY_STATE, 1, PMLOGKS("State", qPrintable(currentLevel)), "");
-
-    webos::WebViewBase::MemoryPressureLevel level;
-    if (currentLevel == "medium")
-        level = webos::WebViewBase::MEMORY_PRESSURE_LOW;
-    else if (currentLevel == "critical" || currentLevel == "low")
-        level = webos::WebViewBase::MEMORY_PRESSURE_CRITICAL;
-    else
-        level = webos::WebViewBase::MEMORY_PRESSURE_NONE;
-    WebAppManagerService::notifyMemoryPressure(level);
+    WebAppManagerService::onMemoryThresholdChanged(currentLevel);
 }
 
 void WebAppManagerServiceLuna::applicationManagerConnectCallback(QJsonObject reply)
@@ -504,10 +588,31 @@ void WebAppManagerServiceLuna::applicationManagerConnectCallback(QJsonObject rep
 
 void WebAppManagerServiceLuna::getAppStatusCallback(QJsonObject reply)
 {
+    // The first reply lists all installed apps, following ones report changes.
+    // Keep the descriptors of web apps built ahead of their launch.
+    if (reply["apps"].isArray()) {
+        QJsonArray apps = reply["apps"].toArray();
+        for (int i = 0; i < apps.size(); i++) {
+            QJsonObject appObject = apps[i].toObject();
+            if (appObject["type"].toString() == "web")
+                WebAppManagerService::updateApplicationDescription(appObject);
+        }
+    }
+
+    if (reply["change"].toString() == "added" ||
+        reply["change"].toString() == "updated") {
+        QJsonObject appObject = reply["app"].toObject();
+        if (appObject["type"].toString() == "web")
+            WebAppManagerService::updateApplicationDescription(appObject, true);
+        else
+            WebAppManagerService::removeApplicationDescription(appObject["id"].toString());
+    }
+
     if (reply["change"].toString() == "removed") {
         QJsonObject appObject = reply["app"].toObject();
         QString appId = appObject["id"].toString();
 
+        WebAppManagerService::removeApplicationDescription(appId);
         WebAppManagerService::deleteStorageData(appId);
     }
     if (reply["change"].toString() == "removed" ||
@@ -534,6 +639,7 @@ void WebAppManagerServiceLuna::getForegroundAppInfoCallback(QJsonObject reply)
             QString appId = reply["appId"].toString();
             webos::Runtime::GetInstance()->SetIsForegroundAppEnyo(
                 WebAppManagerService::isEnyoApp(appId));
+            WebAppManagerService::onForegroundAppChanged(appId);
         }
     }
 }
@@ -553,6 +659,8 @@ void WebAppManagerServiceLuna::getBootStatusCallback(QJsonObject reply)
 {
     QJsonObject bootd_signals = reply["signals"].toObject();
     m_bootDone = bootd_signals["boot-done"].toBool();
+    if (m_bootDone)
+        WebAppManagerService::onBootDone();
 }
 
 void WebAppManagerServiceLuna::closeApp(const std::string& id)
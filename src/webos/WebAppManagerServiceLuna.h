@@ -44,6 +44,10 @@ public:
     QJsonObject pauseApp(QJsonObject request) override;
     QJsonObject clearBrowsingData(QJsonObject request) override;
     QJsonObject webProcessCreated(QJsonObject request, bool subscribed) override;
+    QJsonObject getLaunchMetrics(QJsonObject request) override;
+    QJsonObject launchApps(QJsonObject request) override;
+    QJsonObject killApps(QJsonObject request) override;
+    QJsonObject closeByProcessIds(QJsonObject request) override;
 
     // PlamServiceBase
     void didConnect() override;
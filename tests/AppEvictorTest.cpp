@@ -0,0 +1,196 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "AppEvictorTest.h"
+
+#include <glib.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "AppEvictor.h"
+#include "LocalMemoryMonitor.h"
+
+static AppEvictor::Victim candidate(uint32_t pid)
+{
+    return AppEvictor::Victim{nullptr, pid, 0, 0};
+}
+
+static AppEvictor::AppState backgroundApp(uint32_t pid, int64_t lastForegroundTime)
+{
+    return AppEvictor::AppState{nullptr, pid, false, false, false, false, false, lastForegroundTime};
+}
+
+static bool writeLevel(const QString& path, const QByteArray& level)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(level) == level.size();
+}
+
+// Closes what AppEvictor picks whenever the stand-in reports pressure,
+// as WebAppManager does; each app has a renderer of 400 kB to itself
+struct PressureMonitor : public LocalMemoryMonitor {
+    PressureMonitor(const QString& levelFile, const std::vector<AppEvictor::AppState>& apps)
+        : LocalMemoryMonitor(10, levelFile)
+        , apps(apps)
+    {
+    }
+
+    void thresholdChanged(const QString& level) override
+    {
+        levels.push_back(level);
+        if (level == "normal")
+            return;
+
+        QHash<uint32_t, unsigned> appsPerProcess;
+        QHash<uint32_t, uint64_t> processKB;
+        for (const AppEvictor::AppState& app : apps) {
+            appsPerProcess[app.pid]++;
+            processKB[app.pid] = 400;
+        }
+        victims = AppEvictor::pick(AppEvictor::candidates(apps, 5000), appsPerProcess, processKB, 700);
+    }
+
+    std::vector<AppEvictor::AppState> apps;
+    std::vector<QString> levels;
+    std::vector<AppEvictor::Victim> victims;
+};
+
+// Iterates the default main context, which the monitor's timer runs on
+static bool pollUntil(const PressureMonitor& monitor, size_t levels)
+{
+    gint64 deadline = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+    while (monitor.levels.size() < levels) {
+        if (g_get_monotonic_time() > deadline)
+            return false;
+        if (!g_main_context_iteration(nullptr, FALSE))
+            g_usleep(1000);
+    }
+    return true;
+}
+
+void AppEvictorTest::sharedRendererIsCreditedByShare()
+{
+    // A foreground app keeps the renderer alive
+    QHash<uint32_t, unsigned> appsPerProcess{{100, 2}};
+    QHash<uint32_t, uint64_t> processKB{{100, 1000}};
+
+    std::vector<AppEvictor::Victim> victims =
+        AppEvictor::pick({candidate(100)}, appsPerProcess, processKB, 10000);
+    QCOMPARE(victims.size(), size_t(1));
+    QCOMPARE(victims[0].freedKB, uint64_t(500));
+}
+
+void AppEvictorTest::lastAppFreesWhatIsLeft()
+{
+    QHash<uint32_t, unsigned> appsPerProcess{{100, 3}, {200, 1}};
+    QHash<uint32_t, uint64_t> processKB{{100, 1000}, {200, 600}};
+
+    std::vector<AppEvictor::Victim> victims =
+        AppEvictor::pick({candidate(100), candidate(200), candidate(100), candidate(100)},
+                         appsPerProcess, processKB, 10000);
+    QCOMPARE(victims.size(), size_t(4));
+    QCOMPARE(victims[0].freedKB, uint64_t(333));
+    QCOMPARE(victims[1].freedKB, uint64_t(600));
+    QCOMPARE(victims[2].freedKB, uint64_t(333));
+    // Ends the renderer; all of it is accounted for
+    QCOMPARE(victims[3].freedKB, uint64_t(334));
+}
+
+void AppEvictorTest::stopsOnceBudgetIsCovered()
+{
+    QHash<uint32_t, unsigned> appsPerProcess{{100, 1}, {200, 1}, {300, 1}};
+    QHash<uint32_t, uint64_t> processKB{{100, 400}, {200, 400}, {300, 400}};
+
+    std::vector<AppEvictor::Victim> victims =
+        AppEvictor::pick({candidate(100), candidate(200), candidate(300)},
+                         appsPerProcess, processKB, 700);
+    QCOMPARE(victims.size(), size_t(2));
+    QCOMPARE(victims[0].pid, uint32_t(100));
+    QCOMPARE(victims[1].pid, uint32_t(200));
+}
+
+void AppEvictorTest::appWithoutRendererFreesNothing()
+{
+    std::vector<AppEvictor::Victim> victims =
+        AppEvictor::pick({candidate(0)}, QHash<uint32_t, unsigned>(), QHash<uint32_t, uint64_t>(), 100);
+    QCOMPARE(victims.size(), size_t(1));
+    QCOMPARE(victims[0].freedKB, uint64_t(0));
+}
+
+void AppEvictorTest::candidatesAreBackgroundAppsInLruOrder()
+{
+    std::vector<AppEvictor::AppState> apps{
+        backgroundApp(100, 3000),
+        backgroundApp(200, 1000),
+        backgroundApp(300, 2000),
+    };
+
+    // Longer in the background than any of the above, but not to be closed
+    AppEvictor::AppState foreground = backgroundApp(400, 0);
+    foreground.foreground = true;
+    AppEvictor::AppState keepAlive = backgroundApp(500, 0);
+    keepAlive.keepAlive = true;
+    AppEvictor::AppState preloaded = backgroundApp(600, 0);
+    preloaded.preloaded = true;
+    AppEvictor::AppState discarded = backgroundApp(700, 0);
+    discarded.discarded = true;
+    AppEvictor::AppState closing = backgroundApp(800, 0);
+    closing.closing = true;
+    apps.insert(apps.end(), {foreground, keepAlive, preloaded, discarded, closing});
+
+    std::vector<AppEvictor::Victim> candidates = AppEvictor::candidates(apps, 5000);
+    QCOMPARE(candidates.size(), size_t(3));
+    QCOMPARE(candidates[0].pid, uint32_t(200));
+    QCOMPARE(candidates[0].backgroundTime, int64_t(4000));
+    QCOMPARE(candidates[1].pid, uint32_t(300));
+    QCOMPARE(candidates[2].pid, uint32_t(100));
+    QCOMPARE(candidates[2].backgroundTime, int64_t(2000));
+}
+
+void AppEvictorTest::memoryLevelsFollowAvailableMemory()
+{
+    QCOMPARE(LocalMemoryMonitor::levelFor(200, 1000), QString("normal"));
+    QCOMPARE(LocalMemoryMonitor::levelFor(199, 1000), QString("medium"));
+    QCOMPARE(LocalMemoryMonitor::levelFor(99, 1000), QString("low"));
+    QCOMPARE(LocalMemoryMonitor::levelFor(49, 1000), QString("critical"));
+}
+
+void AppEvictorTest::localMonitorPressureClosesLruApps()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString levelFile = dir.path() + "/level";
+    QVERIFY(writeLevel(levelFile, "critical\n"));
+
+    PressureMonitor monitor(levelFile, {backgroundApp(100, 3000), backgroundApp(200, 1000), backgroundApp(300, 2000)});
+    QVERIFY(pollUntil(monitor, 1));
+    QCOMPARE(monitor.levels.back(), QString("critical"));
+    QCOMPARE(monitor.level(), QString("critical"));
+    QCOMPARE(monitor.victims.size(), size_t(2));
+    QCOMPARE(monitor.victims[0].pid, uint32_t(200));
+    QCOMPARE(monitor.victims[1].pid, uint32_t(300));
+    QCOMPARE(monitor.victims[0].freedKB + monitor.victims[1].freedKB, uint64_t(800));
+
+    // Only changes are reported
+    monitor.victims.clear();
+    QVERIFY(writeLevel(levelFile, "normal\n"));
+    QVERIFY(pollUntil(monitor, 2));
+    QCOMPARE(monitor.levels.back(), QString("normal"));
+    QVERIFY(monitor.victims.empty());
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "OomScoreManagerTest.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "OomScoreManager.h"
+
+typedef OomScoreManager::AppTier AppTier;
+
+static QByteArray scoreAdj(const QTemporaryDir& proc, uint32_t pid)
+{
+    QFile file(proc.path() + QStringLiteral("/%1/oom_score_adj").arg(pid));
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void OomScoreManagerTest::rendererTakesBestTierOfItsApps()
+{
+    QHash<uint32_t, OomScoreManager::Tier> tiers = OomScoreManager::rendererTiers({
+        AppTier{100, "system", OomScoreManager::TierHidden},
+        AppTier{100, "system", OomScoreManager::TierForeground},
+        AppTier{200, "system", OomScoreManager::TierPreloaded},
+        AppTier{200, "system", OomScoreManager::TierKeepAlive},
+    });
+    QCOMPARE(tiers.size(), 2);
+    QCOMPARE(tiers.value(100), OomScoreManager::TierForeground);
+    QCOMPARE(tiers.value(200), OomScoreManager::TierKeepAlive);
+}
+
+void OomScoreManagerTest::groupIsHeldAtKeepAlive()
+{
+    QHash<uint32_t, OomScoreManager::Tier> tiers = OomScoreManager::rendererTiers({
+        AppTier{100, "group", OomScoreManager::TierForeground},
+        AppTier{200, "group", OomScoreManager::TierPreloaded},
+        // Every app shares the "system" key; it does not hold anything
+        AppTier{300, "system", OomScoreManager::TierForeground},
+        AppTier{400, "system", OomScoreManager::TierHidden},
+    });
+    QCOMPARE(tiers.value(200), OomScoreManager::TierKeepAlive);
+    QCOMPARE(tiers.value(400), OomScoreManager::TierHidden);
+}
+
+void OomScoreManagerTest::scoresAreWrittenUnderProcRoot()
+{
+    QTemporaryDir proc;
+    QVERIFY(proc.isValid());
+    QVERIFY(QDir(proc.path()).mkpath("100"));
+    QVERIFY(QDir(proc.path()).mkpath("200"));
+
+    OomScoreManager manager(proc.path());
+    manager.apply({{100, OomScoreManager::TierForeground}, {200, OomScoreManager::TierHidden}});
+    QCOMPARE(scoreAdj(proc, 100), QByteArray("0"));
+    QCOMPARE(scoreAdj(proc, 200), QByteArray("600"));
+
+    // Unchanged tiers are not written again
+    QFile file(proc.path() + "/200/oom_score_adj");
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.close();
+    manager.apply({{100, OomScoreManager::TierHidden}, {200, OomScoreManager::TierHidden}});
+    QCOMPARE(scoreAdj(proc, 100), QByteArray("600"));
+    QCOMPARE(scoreAdj(proc, 200), QByteArray());
+
+    // No such process
+    manager.apply({{100, OomScoreManager::TierHidden}, {200, OomScoreManager::TierHidden},
+                   {300, OomScoreManager::TierPreloaded}});
+    QJsonObject stats = manager.stats();
+    QCOMPARE(stats["writes"].toInt(), 3);
+    QCOMPARE(stats["failures"].toInt(), 1);
+}
+
+void OomScoreManagerTest::rendererLeftWithoutAppsIsEmpty()
+{
+    QTemporaryDir proc;
+    QVERIFY(proc.isValid());
+    QVERIFY(QDir(proc.path()).mkpath("100"));
+    QVERIFY(QDir(proc.path()).mkpath("200"));
+
+    OomScoreManager manager(proc.path());
+    manager.apply({{100, OomScoreManager::TierForeground}, {200, OomScoreManager::TierHidden}});
+    manager.apply({{100, OomScoreManager::TierForeground}});
+    QCOMPARE(scoreAdj(proc, 200), QByteArray("1000"));
+    QCOMPARE(manager.stats()["renderers"].toObject()["empty"].toInt(), 1);
+
+    // Gone for good
+    QVERIFY(QDir(proc.path() + "/200").removeRecursively());
+    manager.apply({{100, OomScoreManager::TierForeground}});
+    QCOMPARE(manager.stats()["renderers"].toObject()["empty"].toInt(), 0);
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "ProcessKeyIndexTest.h"
+
+#include <QStringList>
+#include <QtTest>
+
+#include "ProcessKeyIndex.h"
+
+void ProcessKeyIndexTest::exactIds()
+{
+    ProcessKeyIndex index;
+    index.addAppIds("com.webos.app.a,com.webos.app.b");
+    index.addAppIds("com.webos.app.c");
+
+    QCOMPARE(index.find("com.webos.app.b", "default"), QString("com.webos.app.a,com.webos.app.b"));
+    QCOMPARE(index.find("com.webos.app.c", "default"), QString("com.webos.app.c"));
+    QCOMPARE(index.find("com.webos.app", "default"), QString());
+    QCOMPARE(index.find("com.webos.app.cc", "default"), QString());
+}
+
+void ProcessKeyIndexTest::longestPrefixWins()
+{
+    ProcessKeyIndex index;
+    index.addAppIds("com.webos.*");
+    index.addAppIds("com.webos.app.*,com.lge.*");
+    index.addAppIds("com.webos.app.settings");
+
+    QCOMPARE(index.find("com.webos.service", "default"), QString("com.webos.*"));
+    QCOMPARE(index.find("com.webos.app.home", "default"), QString("com.webos.app.*,com.lge.*"));
+    QCOMPARE(index.find("com.lge.app.tv", "default"), QString("com.webos.app.*,com.lge.*"));
+    // An exact id beats any prefix
+    QCOMPARE(index.find("com.webos.app.settings", "default"), QString("com.webos.app.settings"));
+    QCOMPARE(index.find("org.example.app", "default"), QString());
+}
+
+void ProcessKeyIndexTest::trustLevels()
+{
+    ProcessKeyIndex index;
+    index.addAppIds("com.webos.app.*");
+    index.addTrustLevels("default,trusted");
+    index.addTrustLevels("netcast");
+
+    QCOMPARE(index.find("org.example.app", "trusted"), QString("default,trusted"));
+    QCOMPARE(index.find("org.example.app", "netcast"), QString("netcast"));
+    QCOMPARE(index.find("org.example.app", "unknown"), QString());
+    // Ids and prefixes come before the trust level
+    QCOMPARE(index.find("com.webos.app.home", "netcast"), QString("com.webos.app.*"));
+}
+
+void ProcessKeyIndexTest::firstEntryWins()
+{
+    ProcessKeyIndex index;
+    index.addAppIds("com.webos.app.a");
+    index.addAppIds("com.webos.app.a,com.webos.app.b");
+    index.addAppIds("com.webos.*");
+    index.addAppIds("com.webos.*,com.lge.*");
+
+    QCOMPARE(index.find("com.webos.app.a", "default"), QString("com.webos.app.a"));
+    QCOMPARE(index.find("com.webos.app.home", "default"), QString("com.webos.*"));
+
+    index.clear();
+    QCOMPARE(index.find("com.webos.app.a", "default"), QString());
+}
+
+void ProcessKeyIndexTest::lookupBenchmark()
+{
+    // About the size of a large webProcessList policy: 200 id entries,
+    // 80 prefix entries and 20 trust level entries
+    ProcessKeyIndex index;
+    for (int i = 0; i < 200; i++)
+        index.addAppIds(QStringLiteral("com.vendor%1.app%2,com.vendor%1.app%2.extra").arg(i % 20).arg(i));
+    for (int i = 0; i < 80; i++)
+        index.addAppIds(QStringLiteral("com.group%1.*").arg(i));
+    for (int i = 0; i < 20; i++)
+        index.addTrustLevels(QStringLiteral("level%1").arg(i));
+
+    // Apps hitting every kind of entry, and some hitting none
+    QStringList appIds;
+    QStringList trustLevels;
+    for (int i = 0; i < 300; i++) {
+        switch (i % 4) {
+            case 0: appIds << QStringLiteral("com.vendor%1.app%2").arg(i % 20).arg(i % 200); break;
+            case 1: appIds << QStringLiteral("com.group%1.app%2").arg(i % 80).arg(i); break;
+            case 2: appIds << QStringLiteral("org.example%1").arg(i); break;
+            default: appIds << QStringLiteral("net.unmatched.app%1").arg(i); break;
+        }
+        trustLevels << QStringLiteral("level%1").arg(i % 40);
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (int i = 0; i < appIds.size(); i++) {
+            if (!index.find(appIds[i], trustLevels[i]).isEmpty())
+                found++;
+        }
+    }
+    QVERIFY(found > 0);
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "RendererPriorityManagerTest.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "RendererPriorityManager.h"
+
+typedef RendererPriorityManager::AppState AppState;
+
+static QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void RendererPriorityManagerTest::rendererTiers()
+{
+    QHash<uint32_t, RendererPriorityManager::Tier> tiers = RendererPriorityManager::rendererTiers({
+        AppState{100, "group", false},
+        AppState{100, "group", true},
+        AppState{200, "group", false},
+        // Every app shares the "system" key; it does not share a renderer's tier
+        AppState{300, "system", true},
+        AppState{400, "system", false},
+    });
+    QCOMPARE(tiers.size(), 4);
+    QCOMPARE(tiers.value(100), RendererPriorityManager::TierForeground);
+    QCOMPARE(tiers.value(200), RendererPriorityManager::TierShared);
+    QCOMPARE(tiers.value(300), RendererPriorityManager::TierForeground);
+    QCOMPARE(tiers.value(400), RendererPriorityManager::TierBackground);
+}
+
+void RendererPriorityManagerTest::cgroupsAreSetUp()
+{
+    QTemporaryDir cgroup;
+    QVERIFY(cgroup.isValid());
+    QString root = cgroup.path() + "/wam";
+
+    RendererPriorityManager manager(root, "20000 100000");
+    QCOMPARE(manager.stats()["mode"].toString(), QString("cgroup"));
+    QCOMPARE(readFile(root + "/cgroup.subtree_control"), QByteArray("+cpu +io"));
+    QCOMPARE(readFile(root + "/foreground/cpu.weight"), QByteArray("1000"));
+    QCOMPARE(readFile(root + "/shared/cpu.weight"), QByteArray("100"));
+    QCOMPARE(readFile(root + "/background/cpu.weight"), QByteArray("20"));
+    QCOMPARE(readFile(root + "/background/io.weight"), QByteArray("default 25"));
+    QCOMPARE(readFile(root + "/background/cpu.max"), QByteArray("20000 100000"));
+}
+
+void RendererPriorityManagerTest::renderersMoveBetweenCgroups()
+{
+    QTemporaryDir cgroup;
+    QVERIFY(cgroup.isValid());
+
+    RendererPriorityManager manager(cgroup.path(), QString());
+    manager.apply({{100, RendererPriorityManager::TierForeground}});
+    QCOMPARE(readFile(cgroup.path() + "/foreground/cgroup.procs"), QByteArray("100"));
+
+    manager.apply({{100, RendererPriorityManager::TierBackground}});
+    QCOMPARE(readFile(cgroup.path() + "/background/cgroup.procs"), QByteArray("100"));
+
+    // Unchanged tiers are not moved again
+    manager.apply({{100, RendererPriorityManager::TierBackground}});
+    QJsonObject stats = manager.stats();
+    QCOMPARE(stats["moves"].toInt(), 2);
+    QCOMPARE(stats["failures"].toInt(), 0);
+    QCOMPARE(stats["renderers"].toObject()["background"].toInt(), 1);
+}
+
+void RendererPriorityManagerTest::failedMovesAreRetried()
+{
+    QTemporaryDir cgroup;
+    QVERIFY(cgroup.isValid());
+
+    RendererPriorityManager manager(cgroup.path(), QString());
+    // Above any pid_max, so that the nice fallback fails as well
+    const uint32_t pid = 4194305;
+    QVERIFY(QDir(cgroup.path() + "/foreground").removeRecursively());
+    manager.apply({{pid, RendererPriorityManager::TierForeground}});
+    QJsonObject stats = manager.stats();
+    QCOMPARE(stats["failures"].toInt(), 1);
+    QCOMPARE(stats["renderers"].toObject()["foreground"].toInt(), 0);
+
+    // The same tier is tried again on the next rebalance
+    QVERIFY(QDir().mkpath(cgroup.path() + "/foreground"));
+    manager.apply({{pid, RendererPriorityManager::TierForeground}});
+    QCOMPARE(readFile(cgroup.path() + "/foreground/cgroup.procs"), QByteArray::number(pid));
+    stats = manager.stats();
+    QCOMPARE(stats["moves"].toInt(), 1);
+    QCOMPARE(stats["renderers"].toObject()["foreground"].toInt(), 1);
+}
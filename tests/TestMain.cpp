@@ -0,0 +1,53 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <QCoreApplication>
+#include <QtTest>
+
+#include "AppEvictorTest.h"
+#include "OomScoreManagerTest.h"
+#include "ProcessKeyIndexTest.h"
+#include "RendererPriorityManagerTest.h"
+#include "TimerWheelTest.h"
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int failed = 0;
+    {
+        AppEvictorTest test;
+        failed += QTest::qExec(&test, argc, argv);
+    }
+    {
+        OomScoreManagerTest test;
+        failed += QTest::qExec(&test, argc, argv);
+    }
+    {
+        ProcessKeyIndexTest test;
+        failed += QTest::qExec(&test, argc, argv);
+    }
+    {
+        RendererPriorityManagerTest test;
+        failed += QTest::qExec(&test, argc, argv);
+    }
+    {
+        TimerWheelTest test;
+        failed += QTest::qExec(&test, argc, argv);
+    }
+    return failed ? 1 : 0;
+}
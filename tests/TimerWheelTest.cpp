@@ -0,0 +1,195 @@
+// Copyright (c) 2019 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "TimerWheelTest.h"
+
+#include <functional>
+#include <vector>
+
+#include <glib.h>
+
+#include <QJsonObject>
+#include <QtTest>
+
+#include "Timer.h"
+
+static double wakeups()
+{
+    return TimerWheel::instance()->stats()["wakeups"].toDouble();
+}
+
+// Iterates the default main context, which the wheel's GSource is attached to
+static bool runUntil(const std::function<bool()>& done, int timeoutMs = 5000)
+{
+    gint64 deadline = g_get_monotonic_time() + static_cast<gint64>(timeoutMs) * 1000;
+    while (!done()) {
+        if (g_get_monotonic_time() > deadline)
+            return false;
+        if (!g_main_context_iteration(nullptr, FALSE))
+            g_usleep(1000);
+    }
+    return true;
+}
+
+struct Callback {
+    Callback() : count(0), wakeup(0) {}
+
+    void fire()
+    {
+        count++;
+        wakeup = wakeups();
+        if (run)
+            run();
+    }
+
+    OneShotTimer<Callback> timer;
+    std::function<void()> run;
+    int count;
+    double wakeup; // the wheel's wakeup it last fired in
+};
+
+// Only fired by countsWakeupsPerOwner(), so that its owner counts are its own
+struct CountedCallback {
+    CountedCallback() : count(0) {}
+
+    void fire() { count++; }
+
+    OneShotTimer<CountedCallback> timer;
+    int count;
+};
+
+void TimerWheelTest::cascadesFromEveryLevel()
+{
+    Callback level0, level1, level2, level3;
+    std::vector<Callback*> order;
+    for (Callback* callback : {&level0, &level1, &level2, &level3})
+        callback->run = [&order, callback] { order.push_back(callback); };
+
+    // Level 0 slots span 1 ms, level 1 64 ms, level 2 4096 ms and level 3 262144 ms
+    level3.timer.start(1000000, &level3, &Callback::fire);
+    level2.timer.start(100000, &level2, &Callback::fire);
+    level1.timer.start(1000, &level1, &Callback::fire);
+    level0.timer.start(10, &level0, &Callback::fire);
+
+    QVERIFY(runUntil([&] { return level0.count == 1; }));
+    QCOMPARE(level1.count, 0);
+
+    TimerWheel::instance()->skip(1000);
+    QVERIFY(runUntil([&] { return level1.count == 1; }));
+    QCOMPARE(level2.count, 0);
+
+    TimerWheel::instance()->skip(99000);
+    QVERIFY(runUntil([&] { return level2.count == 1; }));
+    QCOMPARE(level3.count, 0);
+    QVERIFY(level3.timer.isRunning());
+
+    TimerWheel::instance()->skip(900000);
+    QVERIFY(runUntil([&] { return level3.count == 1; }));
+    QVERIFY(!level3.timer.isRunning());
+
+    std::vector<Callback*> expected{&level0, &level1, &level2, &level3};
+    QVERIFY(order == expected);
+}
+
+void TimerWheelTest::slackSharesWakeups()
+{
+    Callback aligner, plain, slackA, slackB;
+
+    // Started just after a whole second, the slack timers below round up
+    // to the same next one, while the plain one fires on its own
+    aligner.timer.setSlack(1000);
+    aligner.run = [&] {
+        plain.timer.start(100, &plain, &Callback::fire);
+        slackA.timer.setSlack(1000);
+        slackA.timer.start(100, &slackA, &Callback::fire);
+        slackB.timer.setSlack(1000);
+        slackB.timer.start(400, &slackB, &Callback::fire);
+    };
+    aligner.timer.start(0, &aligner, &Callback::fire);
+
+    QVERIFY(runUntil([&] { return plain.count && slackA.count && slackB.count; }));
+    QCOMPARE(slackA.wakeup, slackB.wakeup);
+    QVERIFY(plain.wakeup < slackA.wakeup);
+}
+
+void TimerWheelTest::zeroDelayWaitsForNextIteration()
+{
+    Callback first, second;
+    first.run = [&] { second.timer.start(0, &second, &Callback::fire); };
+    first.timer.start(0, &first, &Callback::fire);
+
+    QVERIFY(runUntil([&] { return first.count == 1; }));
+    QCOMPARE(second.count, 0);
+    QVERIFY(second.timer.isRunning());
+
+    g_main_context_iteration(nullptr, FALSE);
+    QCOMPARE(second.count, 1);
+    QVERIFY(second.wakeup > first.wakeup);
+}
+
+void TimerWheelTest::dueTimerStoppedOrDeletedByAnother()
+{
+    // Both are due in the same wakeup; whichever fires first stops the other
+    Callback a, b;
+    a.run = [&] { b.timer.stop(); };
+    b.run = [&] { a.timer.stop(); };
+    a.timer.start(0, &a, &Callback::fire);
+    b.timer.start(0, &b, &Callback::fire);
+
+    QVERIFY(runUntil([&] { return a.count + b.count > 0; }));
+    runUntil([] { return false; }, 50);
+    QCOMPARE(a.count + b.count, 1);
+
+    // Or deletes it
+    Callback* c = new Callback;
+    Callback* d = new Callback;
+    int fired = 0;
+    c->run = [&] { fired++; delete d; d = nullptr; };
+    d->run = [&] { fired++; delete c; c = nullptr; };
+    c->timer.start(0, c, &Callback::fire);
+    d->timer.start(0, d, &Callback::fire);
+
+    QVERIFY(runUntil([&] { return fired > 0; }));
+    runUntil([] { return false; }, 50);
+    QCOMPARE(fired, 1);
+    QVERIFY(!c != !d);
+    delete c;
+    delete d;
+}
+
+void TimerWheelTest::countsWakeupsPerOwner()
+{
+    QJsonObject before = TimerWheel::instance()->stats();
+    QJsonObject ownerBefore = before["owners"].toObject()["CountedCallback"].toObject();
+
+    // Started together, they fire in one wakeup
+    CountedCallback x, y;
+    x.timer.start(0, &x, &CountedCallback::fire);
+    y.timer.start(0, &y, &CountedCallback::fire);
+    QVERIFY(runUntil([&] { return x.count && y.count; }));
+
+    QJsonObject after = TimerWheel::instance()->stats();
+    QJsonObject ownerAfter = after["owners"].toObject()["CountedCallback"].toObject();
+    QCOMPARE(ownerAfter["fired"].toDouble() - ownerBefore["fired"].toDouble(), 2.0);
+    QCOMPARE(ownerAfter["wakeups"].toDouble() - ownerBefore["wakeups"].toDouble(), 1.0);
+
+    double newWakeups = after["wakeups"].toDouble() - before["wakeups"].toDouble();
+    QVERIFY(newWakeups >= 1);
+    // Over the last minute, which has seen at least these
+    QVERIFY(qRound(after["wakeupsPerSecond"].toDouble() * 60) >= newWakeups);
+    QCOMPARE(after["timers"].toInt(), 0);
+}
@@ -21,5 +21,11 @@ wamcorelib.file = wamcorelib.pri
 wamlib.file = wamlib.pri
 wamplugin.file = wamplugin.pri
 wam.file = wam.pri
+tests.file = tests.pri
 
 SUBDIRS += wamcorelib wamlib wamplugin wam
+
+# qmake CONFIG+=unit_tests builds the tests as well
+unit_tests {
+    SUBDIRS += tests
+}
@@ -18,15 +18,33 @@ TEMPLATE = lib
 
 include(common.pri)
 
+# ProcessSampler runs a thread of its own
+CONFIG += thread
+
 SOURCES += \
+        AppEvictor.cpp \
         ApplicationDescription.cpp \
+        ApplicationDescriptionCache.cpp \
+        BackgroundLifecycle.cpp \
+        CrashMonitor.cpp \
         DeviceInfo.cpp \
+        LaunchMetrics.cpp \
+        LaunchParams.cpp \
+        LaunchPredictor.cpp \
+        LaunchTimeline.cpp \
+        LocalMemoryMonitor.cpp \
         LogManager.cpp \
         LogManagerPmLog.cpp \
+        MemoryPressureHandler.cpp \
         NetworkStatus.cpp \
         NetworkStatusManager.cpp \
+        OomScoreManager.cpp \
         PalmSystemBase.cpp \
         PlugInService.cpp \
+        ProcessKeyIndex.cpp \
+        ProcessSampler.cpp \
+        RendererPriorityManager.cpp \
+        SuspendDelayLearner.cpp \
         Timer.cpp \
         WebAppBase.cpp \
         WebAppFactoryManager.cpp \
@@ -34,23 +52,40 @@ SOURCES += \
         WebAppManagerConfig.cpp \
         WebAppManagerService.cpp \
         WebAppManagerUtils.cpp \
+        WebAppRegistry.cpp \
         WebPageBase.cpp \
         WebPageObserver.cpp \
         WebProcessManager.cpp
 
 HEADERS += \
+        AppEvictor.h \
         ApplicationDescription.h \
+        ApplicationDescriptionCache.h \
+        BackgroundLifecycle.h \
+        CrashMonitor.h \
         DeviceInfo.h \
+        IdleTimer.h \
+        LaunchMetrics.h \
+        LaunchParams.h \
+        LaunchPredictor.h \
+        LaunchTimeline.h \
+        LocalMemoryMonitor.h \
         LogManager.h \
         LogManagerPmLog.h \
         LogMsgId.h \
+        MemoryPressureHandler.h \
         NetworkStatus.h \
         NetworkStatusManager.h \
         ObserverList.h \
+        OomScoreManager.h \
         PalmSystemBase.h \
         PlatformModuleFactory.h \
         PlugInService.h \
+        ProcessKeyIndex.h \
+        ProcessSampler.h \
+        RendererPriorityManager.h \
         ServiceSender.h \
+        SuspendDelayLearner.h \
         Timer.h \
         WebAppBase.h \
         WebAppFactoryInterface.h \
@@ -59,6 +94,7 @@ HEADERS += \
         WebAppManagerConfig.h \
         WebAppManagerService.h \
         WebAppManagerUtils.h \
+        WebAppRegistry.h \
         WebPageBase.h \
         WebPageObserver.h \
         WebProcessManager.h \
@@ -24,6 +24,7 @@ DEFINES += SECURITY_COMPATIBILITY
 SOURCES += \
     BlinkWebProcessManager.cpp \
     BlinkWebView.cpp \
+    BlinkWebViewPool.cpp \
     BlinkWebViewProfileHelper.cpp \
     DeviceInfoImpl.cpp \
     PalmServiceBase.cpp \
@@ -36,12 +37,14 @@ SOURCES += \
     WebAppManagerServiceLunaImpl.cpp \
     WebAppWayland.cpp \
     WebAppWaylandWindow.cpp \
+    WebAppWaylandWindowPool.cpp \
     WebPageBlink.cpp \
 
 
 HEADERS += \
     BlinkWebProcessManager.h \
     BlinkWebView.h \
+    BlinkWebViewPool.h \
     BlinkWebViewProfileHelper.h \
     DeviceInfoImpl.h \
     PalmServiceBase.h \
@@ -54,6 +57,7 @@ HEADERS += \
     WebAppManagerServiceLunaImpl.h \
     WebAppWayland.h \
     WebAppWaylandWindow.h \
+    WebAppWaylandWindowPool.h \
     WebPageBlinkDelegate.h \
     WebPageBlinkObserver.h \
     WebPageBlink.h \